@@ -8,6 +8,7 @@
 #include "openGlWrapper.hpp"
 #include "shader.hpp"
 #include "particle.hpp"
+#include "rigidBodyWorld.hpp"
 #include "collisions/particleContact.hpp"
 #include "../include/inputsManager.hpp"
 #include "physicEngine.hpp"
@@ -20,10 +21,14 @@ class GameWorld
 {
 public:
 
+	static constexpr double DEFAULT_TIME_STEP = 1. / 60; // Duration (s) of a physics step
+	static const unsigned int DEFAULT_MAX_STEPS_PER_FRAME = 5; // Number of physics steps after which a slow frame stops catching up
+
 	/*
 	 * Constructor
+	 * The physics runs at a fixed `timeStep` whatever the frame rate, with at most `maxStepsPerFrame` steps per frame.
 	 */
-	GameWorld();
+	GameWorld(double timeStep = DEFAULT_TIME_STEP, unsigned int maxStepsPerFrame = DEFAULT_MAX_STEPS_PER_FRAME);
 
 	/*
 	 * Starts and runs the game engine.
@@ -34,7 +39,9 @@ private:
 	PhysicEngine m_physicEngine; // The instance of the physic engine
 	RenderEngine m_renderEngine; // The instance of the render engine
 	GLFWwindow* const m_mainWindow; // The opengl id of the main window
-	std::vector<std::shared_ptr<physicslib::RigidBody>> m_rigidBodies; // List of all rigid bodies in the world
+	physicslib::RigidBodyWorld m_rigidBodies; // All rigid bodies in the world
+	const double m_timeStep; // Duration (s) of a physics step
+	const unsigned int m_maxStepsPerFrame; // Maximum number of physics steps run by a frame
 
 	/*
 	 * Function to get the list of all the pending envent.
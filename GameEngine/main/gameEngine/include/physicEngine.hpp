@@ -4,11 +4,15 @@
 #include "forceGenerator/forceRegister.hpp"
 #include "collisions/contactRegister.hpp"
 #include "rigidBody.hpp"
+#include "rigidBodyWorld.hpp"
+#include "workerPool.hpp"
 #include "forceGenerator/rigidBodyGravityForceGenerator.hpp"
 #include "forceGenerator/rigidBodyDragForceGenerator.hpp"
+#include "forceGenerator/rigidBodyForcePipeline.hpp"
 #include "collisions/primitive.hpp"
 #include "collisions/planePrimitive.hpp"
 #include "collisions/boxPrimitive.hpp"
+#include "collisions/broadPhase.hpp"
 #include "collisions/contact.hpp"
 #include "collisions/planePrimitive.hpp"
 
@@ -21,30 +25,45 @@ class PhysicEngine
 public:
 	/**
 	 * Constructor
+	 * `threadCount` is the number of threads integrating the bodies, 0 uses all the hardware threads
+	 * `broadPhaseType` is the structure finding the bodies next to the walls and the pairs of bodies
 	 */
-	PhysicEngine();
+	PhysicEngine(std::size_t threadCount = 0, physicslib::BroadPhaseType broadPhaseType = physicslib::BroadPhaseType::DYNAMIC_AABB_TREE);
 
 	/**
 	 * Realizes a whole loop of the physic engine. 
 	 * Generates all forces, applies them to objects and detects and resolves collisions.
 	 */
-	void update(std::vector<std::shared_ptr<physicslib::RigidBody>>& rigidBodies, const double deltaTime);
+	void update(physicslib::RigidBodyWorld& rigidBodies, const double deltaTime);
+
+	/**
+	 * Get the pairs of bodies whose bounds overlapped at the last update, each pair once
+	 * They are the candidates of a narrow phase between the bodies.
+	 */
+	const std::vector<std::pair<physicslib::RigidBodyHandle, physicslib::RigidBodyHandle>>& getBodyPairs() const;
 
 private:
-	physicslib::ForceRegister m_forceRegister; // The register containing all forces associated with the object they're applied to.
+	physicslib::ForceRegister m_forceRegister; // The register containing all forces associated with the object they're applied to, kept between the frames
 	physicslib::ContactRegister m_contactRegister; // The register containing all contacts between 2 objects.
+	physicslib::WorkerPool m_workerPool; // The threads running the parallel loops over the bodies
 	const physicslib::PlanePrimitive m_leftPlane;
 	const physicslib::PlanePrimitive m_rightPlane;
 	const physicslib::PlanePrimitive m_topPlane;
 	const physicslib::PlanePrimitive m_bottomPlane;
 
-	std::shared_ptr<physicslib::RigidBodyGravityForceGenerator> gravityGenerator = std::make_shared<physicslib::RigidBodyGravityForceGenerator>(physicslib::Vector3(0, -20, 0));
-	std::shared_ptr<physicslib::RigidBodyDragForceGenerator> dragGenerator = std::make_shared<physicslib::RigidBodyDragForceGenerator>(0.03, 0);
+	// Gravity and drag, applied in a single pass over the bodies
+	const physicslib::RigidBodyForcePipeline<physicslib::RigidBodyGravityForceGenerator, physicslib::RigidBodyDragForceGenerator> m_environmentForces {
+		physicslib::RigidBodyGravityForceGenerator(physicslib::Vector3(0, -20, 0)),
+		physicslib::RigidBodyDragForceGenerator(0.03, 0)
+	};
 
-	/**
-	 * Function that generates all the forces and add them in the force register.
-	 */
-	void generateAllForces(std::vector<std::shared_ptr<physicslib::RigidBody>>& rigidBodies);
+	std::unique_ptr<physicslib::BroadPhase> m_broadPhase; // The structure of the broad phase, kept between the frames
+
+	// Frame data, kept between the frames to reuse its memory
+	std::vector<physicslib::RigidBodyHandle> m_broadPhaseBodies; // The bodies crossing a plane
+	std::vector<std::pair<physicslib::RigidBodyHandle, physicslib::RigidBodyHandle>> m_bodyPairs; // The pairs of bodies found by the broad phase
+	std::vector<std::pair<physicslib::Vector3, const physicslib::PlanePrimitive*>> m_possibleCollisions; // The result of the broad phase
+	std::vector<physicslib::Contact> m_collisionData; // The result of the narrow phase
 
 	/**
 	 * Function that generates collision data between two primitives
@@ -54,10 +73,15 @@ private:
 	/*
 	 * Function that realize the broad phase of the collision detection.
 	 */
-	void broadPhase(std::vector<std::shared_ptr<physicslib::RigidBody>>& rigidBodies, std::vector<std::pair<physicslib::Vector3, const physicslib::PlanePrimitive*>>& result);
+	void broadPhase(physicslib::RigidBodyWorld& rigidBodies, std::vector<std::pair<physicslib::Vector3, const physicslib::PlanePrimitive*>>& result);
+
+	/**
+	 * Get the bounds of the half-space behind an axis-aligned plane, where the bodies collide with it
+	 */
+	static physicslib::BoundingBox getHalfSpaceBounds(const physicslib::PlanePrimitive& plane);
 
 	/**
 	 * Function that realize the narrow phase of the collision detection.
 	 */
-	std::vector<physicslib::Contact> narrowPhase(std::vector<std::pair<physicslib::Vector3, const physicslib::PlanePrimitive*>>& possibleCollisions);
+	void narrowPhase(const std::vector<std::pair<physicslib::Vector3, const physicslib::PlanePrimitive*>>& possibleCollisions, std::vector<physicslib::Contact>& collisionData);
 };
\ No newline at end of file
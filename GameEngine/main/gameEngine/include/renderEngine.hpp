@@ -4,6 +4,7 @@
 #include "shader.hpp"
 #include <unordered_map>
 #include "rigidBody.hpp"
+#include "rigidBodyWorld.hpp"
 
 /*
  * This class manages all the display.
@@ -18,8 +19,9 @@ public:
 
 	/*
 	 * The function to call to render and display the game to the screen
+	 * The bodies are drawn at `interpolation` between their two last physics states.
 	 */
-	void render(const std::vector<std::shared_ptr<physicslib::RigidBody>>& bodies);
+	void render(const physicslib::RigidBodyWorld& bodies, physicslib::real interpolation = 1);
 
 	/*
 	 * Getter for the m_openGlWrapper attribute
@@ -49,9 +51,10 @@ private:
 	std::unordered_map<ShaderProgramType, opengl_wrapper::Shader> m_shaderPrograms; // The list of all the shader programm
 	const opengl_wrapper::OpenGlWrapper m_openGlWrapper; // The instance of the opengl wrapper
 	GLFWwindow* const m_mainWindow; // The opengl id of the main window.
+	std::vector<physicslib::Vector3> m_vertices; // The vertices of the current frame, kept to reuse its memory
 
 	/*
 	 * Function to effectivly draw the display.
 	 */
-	void draw(const std::vector<std::shared_ptr<physicslib::RigidBody>>& bodies);
+	void draw(const physicslib::RigidBodyWorld& bodies, physicslib::real interpolation);
 };
\ No newline at end of file
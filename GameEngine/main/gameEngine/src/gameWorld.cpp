@@ -5,7 +5,8 @@
 #include <cstdlib>
 #include <ctime>
 
-GameWorld::GameWorld(): m_mainWindow(m_renderEngine.getMainWindow())
+GameWorld::GameWorld(const double timeStep, const unsigned int maxStepsPerFrame):
+	m_mainWindow(m_renderEngine.getMainWindow()), m_timeStep(timeStep), m_maxStepsPerFrame(maxStepsPerFrame)
 {
 	const opengl_wrapper::OpenGlWrapper& openGlWrapper = m_renderEngine.getOpenGlWrapper();
 
@@ -19,29 +20,38 @@ GameWorld::GameWorld(): m_mainWindow(m_renderEngine.getMainWindow())
 
 void GameWorld::run()
 {
-	double frametime = 0.033333;//first frame considered at 30fps
+	// The elapsed time is accumulated and consumed by fixed physics steps, the remainder is carried to the next frame
+	double accumulatedTime = 0;
+	auto previousTime(std::chrono::steady_clock::now());
 
 	// game loops
 	const opengl_wrapper::OpenGlWrapper& openGlWrapper = m_renderEngine.getOpenGlWrapper();
 	while (!openGlWrapper.windowShouldClose(m_mainWindow))
 	{
 		// manage frame time
-		auto start(std::chrono::system_clock::now());
+		auto currentTime(std::chrono::steady_clock::now());
+		std::chrono::duration<double> elapsedSeconds = currentTime - previousTime;
+		previousTime = currentTime;
+		accumulatedTime += elapsedSeconds.count();
 
 		// input
 		auto pendingIntentions = getPendingIntentions();
 
 		// logic
 		processInputs(pendingIntentions);
-		m_physicEngine.update(m_rigidBodies, frametime);
+		unsigned int stepCount = 0;
+		while (accumulatedTime >= m_timeStep && stepCount < m_maxStepsPerFrame)
+		{
+			m_physicEngine.update(m_rigidBodies, m_timeStep);
+			accumulatedTime -= m_timeStep;
+			++stepCount;
+		}
 
-		// render
-		m_renderEngine.render(m_rigidBodies);
+		// When the physics cannot keep up, the late time is dropped rather than piling up over the next frames
+		accumulatedTime = std::min(accumulatedTime, m_timeStep);
 
-		// manage frame time
-		auto end(std::chrono::system_clock::now());
-		std::chrono::duration<double> elapsedSeconds = end - start;
-		frametime = elapsedSeconds.count();//update frametime using last frame
+		// render, between the two last physics states
+		m_renderEngine.render(m_rigidBodies, static_cast<physicslib::real>(accumulatedTime / m_timeStep));
 	}
 }
 
@@ -76,12 +86,12 @@ void GameWorld::processIntention(const InputsManager::Intention intention)
 
 
 
-		std::shared_ptr<physicslib::RigidBody> boxRigidBody = std::make_shared<physicslib::RigidBody>(
+		physicslib::RigidBody boxRigidBody(
 			1., 1., physicslib::Vector3(10, 3, 3),
 			physicslib::Vector3(rand() % 41 - 20., rand() % 41 - 20., 0), physicslib::Vector3(rand() % 81 - 40., rand() % 81 - 40., 0), physicslib::Vector3(),
 			physicslib::Quaternion(1, 0, 0, 0), physicslib::Vector3(1, 1, 1)
 		);
 
-		m_rigidBodies.push_back(boxRigidBody);
+		m_rigidBodies.add(boxRigidBody);
 	}
 }
\ No newline at end of file
@@ -4,48 +4,43 @@
 #include "math/vector3.hpp"
 #include "collisions/planePrimitive.hpp"
 #include "collisions/boxPrimitive.hpp"
-#include "collisions/octree.hpp"
+#include <cmath>
 #include <chrono>
 #include <thread>
 
 
-PhysicEngine::PhysicEngine()
-	: m_leftPlane(physicslib::Vector3(1, 0, 0), 55)
+PhysicEngine::PhysicEngine(std::size_t threadCount, physicslib::BroadPhaseType broadPhaseType)
+	: m_workerPool(threadCount)
+	, m_leftPlane(physicslib::Vector3(1, 0, 0), 55)
 	, m_rightPlane(physicslib::Vector3(-1, 0, 0), -55)
 	, m_topPlane(physicslib::Vector3(0, -1, 0), -41)
 	, m_bottomPlane(physicslib::Vector3(0, 1, 0), 41)
+	, m_broadPhase(physicslib::createBroadPhase(broadPhaseType, physicslib::BoundingBox { -55, -41, -500, 110, 82, 1000 }))
 {
-	physicslib::Octree::setBottomPlane(&m_bottomPlane);
-	physicslib::Octree::setTopPlane(&m_topPlane);
-	physicslib::Octree::setRightPlane(&m_rightPlane);
-	physicslib::Octree::setLeftPlane(&m_leftPlane);
+	// Gravity and drag apply to every body, they are registered once for all
+	m_forceRegister.addGlobal(&m_environmentForces);
 }
 
-void PhysicEngine::update(std::vector<std::shared_ptr<physicslib::RigidBody>>& rigidBodies, const double frametime)
+void PhysicEngine::update(physicslib::RigidBodyWorld& rigidBodies, const double frametime)
 {
-	// Generates all forces and add them in the force register
-	generateAllForces(rigidBodies);
-
 	// applies the forces inside the force register
-	m_forceRegister.updateAllForces(frametime);
+	m_forceRegister.updateAllForces(rigidBodies, frametime, m_workerPool);
 
 	// integrate all rigid bodies
-	for (auto& rigidBody : rigidBodies)
-	{
-		rigidBody->integrate(frametime);
-	}
+	rigidBodies.integrate(frametime, m_workerPool);
 
 	// look for collisions and resolve them
-	std::vector<std::pair<physicslib::Vector3, const physicslib::PlanePrimitive*>> result;
-	broadPhase(rigidBodies, result);
-	std::vector<physicslib::Contact> collisionData = narrowPhase(result);
+	m_possibleCollisions.clear();
+	broadPhase(rigidBodies, m_possibleCollisions);
+	m_collisionData.clear();
+	narrowPhase(m_possibleCollisions, m_collisionData);
 
-	for (const physicslib::Contact& contact : collisionData)
+	for (const physicslib::Contact& contact : m_collisionData)
 	{
 		std::cout << contact.toString() << std::endl;
 	}
 
-	if (!collisionData.empty())
+	if (!m_collisionData.empty())
 	{
 		using namespace std::chrono_literals;
 		std::this_thread::sleep_for(1000000s);
@@ -54,46 +49,78 @@ void PhysicEngine::update(std::vector<std::shared_ptr<physicslib::RigidBody>>& r
 
 	// clean registers
 	m_contactRegister.clear();
-	m_forceRegister.clear();
 }
 
-void PhysicEngine::generateAllForces(std::vector<std::shared_ptr<physicslib::RigidBody>>& rigidBodies)
+const std::vector<std::pair<physicslib::RigidBodyHandle, physicslib::RigidBodyHandle>>& PhysicEngine::getBodyPairs() const
+{
+	return m_bodyPairs;
+}
+
+void PhysicEngine::broadPhase(physicslib::RigidBodyWorld& rigidBodies, std::vector<std::pair<physicslib::Vector3, const physicslib::PlanePrimitive*>>& result)
 {
-	for (auto& rigidBody : rigidBodies)
+	m_broadPhase->update(rigidBodies, m_workerPool);
+	m_bodyPairs.clear();
+	m_broadPhase->getOverlappingPairs(m_bodyPairs);
+
+	// A sleeping body touched by an awake body wakes up, so that the contact can move it
+	for (const std::pair<physicslib::RigidBodyHandle, physicslib::RigidBodyHandle>& bodyPair : m_bodyPairs)
 	{
-		m_forceRegister.add(physicslib::ForceRegister::ForceRecord(rigidBody, gravityGenerator));
-		m_forceRegister.add(physicslib::ForceRegister::ForceRecord(rigidBody, dragGenerator));
+		const std::size_t index = rigidBodies.getIndex(bodyPair.first);
+		const std::size_t otherIndex = rigidBodies.getIndex(bodyPair.second);
+		if (rigidBodies.isAwake(index) != rigidBodies.isAwake(otherIndex))
+		{
+			rigidBodies.setAwake(index, true);
+			rigidBodies.setAwake(otherIndex, true);
+		}
+	}
+
+	// The vertices of the bodies crossing a plane are tested against it
+	physicslib::Vector3 vertices[physicslib::BoxPrimitive::VERTEX_COUNT];
+	for (const physicslib::PlanePrimitive* plane : { &m_leftPlane, &m_rightPlane, &m_topPlane, &m_bottomPlane })
+	{
+		m_broadPhaseBodies.clear();
+		m_broadPhase->query(getHalfSpaceBounds(*plane), m_broadPhaseBodies);
+		for (const physicslib::RigidBodyHandle body : m_broadPhaseBodies)
+		{
+			// The sleeping bodies are tested too: a body may have fallen asleep against a plane, or been moved into it
+			const std::size_t index = rigidBodies.getIndex(body);
+			physicslib::BoxPrimitive(rigidBodies.getWorldTransformMatrix(index), rigidBodies.getBoxSize(index)).getVertices(vertices);
+			for (const physicslib::Vector3& vertex : vertices)
+			{
+				result.push_back(std::make_pair(vertex, plane));
+			}
+		}
 	}
 }
 
-void PhysicEngine::broadPhase(std::vector<std::shared_ptr<physicslib::RigidBody>>& rigidBodies, std::vector<std::pair<physicslib::Vector3, const physicslib::PlanePrimitive*>>& result)
+physicslib::BoundingBox PhysicEngine::getHalfSpaceBounds(const physicslib::PlanePrimitive& plane)
 {
-	physicslib::BoundingBox octreeBox;
-	octreeBox.x = 0;
-	octreeBox.y = 0;
-	octreeBox.z = 0;
-	octreeBox.width = 110;
-	octreeBox.height = 82;
-	octreeBox.depth = 1000;
-	physicslib::Octree octree(0, octreeBox);
-
-	std::for_each(rigidBodies.begin(), rigidBodies.end(),
-		[&octree](std::shared_ptr<physicslib::RigidBody> rigidBody)
+	// A point is behind the plane when normal * point + |offset| < 0, see narrowPhase()
+	const physicslib::real extent = 1e6; // Far beyond the playing field
+	const physicslib::Vector3 normal = plane.getNormal();
+	const physicslib::real normalCoordinates[3] = { normal.getX(), normal.getY(), normal.getZ() };
+	physicslib::real minimum[3] = { -extent, -extent, -extent };
+	physicslib::real maximum[3] = { extent, extent, extent };
+	for (std::size_t axis = 0; axis < 3; ++axis)
+	{
+		if (normalCoordinates[axis] > 0)
+		{
+			maximum[axis] = -std::abs(plane.getOffset()) / normalCoordinates[axis];
+		}
+		else if (normalCoordinates[axis] < 0)
 		{
-			std::shared_ptr<physicslib::BoxPrimitive> boxPrimitive = std::make_shared<physicslib::BoxPrimitive>(rigidBody);
-			octree.insert(boxPrimitive);
-		});
+			minimum[axis] = -std::abs(plane.getOffset()) / normalCoordinates[axis];
+		}
+	}
 
-	octree.retrieve(result, true, true, true, true);
+	return physicslib::BoundingBox { minimum[0], minimum[1], minimum[2], maximum[0] - minimum[0], maximum[1] - minimum[1], maximum[2] - minimum[2] };
 }
 
-std::vector<physicslib::Contact> PhysicEngine::narrowPhase(std::vector<std::pair<physicslib::Vector3, const physicslib::PlanePrimitive*>>& possibleCollisions)
+void PhysicEngine::narrowPhase(const std::vector<std::pair<physicslib::Vector3, const physicslib::PlanePrimitive*>>& possibleCollisions, std::vector<physicslib::Contact>& collisionData)
 {
-	std::vector<physicslib::Contact> collisionData;
-
-	for (std::pair<physicslib::Vector3, const physicslib::PlanePrimitive*> collisionPair : possibleCollisions)
+	for (const std::pair<physicslib::Vector3, const physicslib::PlanePrimitive*>& collisionPair : possibleCollisions)
 	{
-		double penetration = collisionPair.second->getNormal() * collisionPair.first + abs(collisionPair.second->getOffset());
+		physicslib::real penetration = collisionPair.second->getNormal() * collisionPair.first + abs(collisionPair.second->getOffset());
 		if (penetration < 0)
 		{
 			// Contact point at half way between point and plane
@@ -102,6 +129,4 @@ std::vector<physicslib::Contact> PhysicEngine::narrowPhase(std::vector<std::pair
 			collisionData.push_back(physicslib::Contact(contactPoint, collisionPair.second->getNormal(), -penetration));
 		}
 	}
-
-	return collisionData;
 }
\ No newline at end of file
@@ -37,14 +37,14 @@ RenderEngine::RenderEngine() : m_openGlWrapper(SCR_WIDTH, SCR_HEIGHT, WINDOW_TIT
 	m_shaderPrograms.insert(std::make_pair(ShaderProgramType::ST_DEFAULT, defaultShader));
 }
 
-void RenderEngine::render(const std::vector<std::shared_ptr<physicslib::RigidBody>>& bodies)
+void RenderEngine::render(const physicslib::RigidBodyWorld& bodies, physicslib::real interpolation)
 {
 	// cleaning screen
 	m_openGlWrapper.clearCurrentWindow();
 	m_openGlWrapper.clearDepthBuffer();
 
 	// drawings
-	draw(bodies);
+	draw(bodies, interpolation);
 
 	// swapping the double buffers
 	m_openGlWrapper.swapGraphicalBuffers(m_mainWindow);
@@ -60,18 +60,18 @@ GLFWwindow* const RenderEngine::getMainWindow() const
 	return m_mainWindow;
 }
 
-void RenderEngine::draw(const std::vector<std::shared_ptr<physicslib::RigidBody>>& bodies)
+void RenderEngine::draw(const physicslib::RigidBodyWorld& bodies, physicslib::real interpolation)
 {
 	opengl_wrapper::Shader currentShader = m_shaderPrograms.at(ShaderProgramType::ST_DEFAULT);
 	currentShader.use();
 
-	std::vector<double> vertices;
-	for (auto body : bodies)
-	{
-		std::vector<double> bodyVertices = body->getBoxVertices();
-		vertices.insert(vertices.end(), bodyVertices.begin(), bodyVertices.end());
-	};
-	std::tuple<unsigned int, unsigned int> openGlBuffers = m_openGlWrapper.createAndBindDataBuffer(vertices);
+	// The bodies write their vertices directly in the frame buffer
+	m_vertices.resize(bodies.getSize() * physicslib::RigidBody::BOX_VERTEX_COUNT);
+	bodies.getBoxVertices(m_vertices, interpolation);
+
+	// Vector3 is 3 packed reals so the buffer can be uploaded as it is (GL_FLOAT or GL_DOUBLE)
+	std::tuple<unsigned int, unsigned int> openGlBuffers = m_openGlWrapper.createAndBindDataBuffer(
+		reinterpret_cast<const physicslib::real*>(m_vertices.data()), 3 * m_vertices.size());
 
 	glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
 
@@ -89,7 +89,7 @@ void RenderEngine::draw(const std::vector<std::shared_ptr<physicslib::RigidBody>
 	projection = glm::perspective(glm::radians(45.0f), (float)SCR_WIDTH / (float)SCR_HEIGHT, 0.1f, 150.0f);
 	currentShader.setUniform("projection", glm::value_ptr(projection));
 
-	glDrawArrays(GL_TRIANGLES, 0, vertices.size()/ 3);
+	glDrawArrays(GL_TRIANGLES, 0, m_vertices.size());
 	m_openGlWrapper.cleanAndDeleteDataBuffers(openGlBuffers);
 }
 
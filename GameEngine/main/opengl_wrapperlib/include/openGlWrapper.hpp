@@ -84,6 +84,20 @@ namespace opengl_wrapper
 		std::tuple<unsigned int, unsigned int> createAndBindDataBuffer
 			(const std::vector<double>& verticesBuffer) const;
 
+		/*
+		 * Create the opengl buffer from the `count` doubles starting at `vertices`.
+		 * Bind the created buffer.
+		 */
+		std::tuple<unsigned int, unsigned int> createAndBindDataBuffer
+			(const double* vertices, std::size_t count) const;
+
+		/*
+		 * Create the opengl buffer from the `count` floats starting at `vertices`.
+		 * Bind the created buffer.
+		 */
+		std::tuple<unsigned int, unsigned int> createAndBindDataBuffer
+			(const float* vertices, std::size_t count) const;
+
 		/*
 		 * Draw the given shaped count times.
 		 * The memory must have been set properly before.
@@ -101,6 +115,13 @@ namespace opengl_wrapper
 		void closeMainWindow() const;
 
 	private:
+		/*
+		 * Create and bind the opengl buffer of `size` bytes starting at `vertices`.
+		 * Each vertex is made of 3 scalars of the given opengl type.
+		 */
+		std::tuple<unsigned int, unsigned int> createAndBindDataBuffer
+			(const void* vertices, std::size_t size, GLenum type, GLsizei scalarSize) const;
+
 		GLFWwindow* m_mainWindow; // The opengl id of the main window
 	};
 }
\ No newline at end of file
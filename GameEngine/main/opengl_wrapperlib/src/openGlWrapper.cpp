@@ -87,8 +87,24 @@ namespace opengl_wrapper
 	std::tuple<unsigned int, unsigned int> OpenGlWrapper::createAndBindDataBuffer
 		(const std::vector<double>& verticesBuffer) const
 	{
-		const double * vertices = verticesBuffer.data();
+		return createAndBindDataBuffer(verticesBuffer.data(), verticesBuffer.size());
+	}
+
+	std::tuple<unsigned int, unsigned int> OpenGlWrapper::createAndBindDataBuffer
+		(const double* vertices, std::size_t count) const
+	{
+		return createAndBindDataBuffer(vertices, count * sizeof(double), GL_DOUBLE, sizeof(double));
+	}
 
+	std::tuple<unsigned int, unsigned int> OpenGlWrapper::createAndBindDataBuffer
+		(const float* vertices, std::size_t count) const
+	{
+		return createAndBindDataBuffer(vertices, count * sizeof(float), GL_FLOAT, sizeof(float));
+	}
+
+	std::tuple<unsigned int, unsigned int> OpenGlWrapper::createAndBindDataBuffer
+		(const void* vertices, std::size_t size, GLenum type, GLsizei scalarSize) const
+	{
 		unsigned int VBO, VAO;
 		glGenVertexArrays(1, &VAO);
 		glGenBuffers(1, &VBO);
@@ -96,10 +112,10 @@ namespace opengl_wrapper
 		glBindVertexArray(VAO);
 
 		glBindBuffer(GL_ARRAY_BUFFER, VBO);
-		glBufferData(GL_ARRAY_BUFFER, verticesBuffer.size() * sizeof(double), vertices, GL_STATIC_DRAW);
+		glBufferData(GL_ARRAY_BUFFER, size, vertices, GL_STATIC_DRAW);
 
 		// position attribute
-		glVertexAttribPointer(0, 3, GL_DOUBLE, GL_FALSE, 3 * sizeof(double), (void*)0);
+		glVertexAttribPointer(0, 3, type, GL_FALSE, 3 * scalarSize, (void*)0);
 		glEnableVertexAttribArray(0);
 
 		return { VAO, VBO };
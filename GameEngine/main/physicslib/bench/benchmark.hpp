@@ -0,0 +1,244 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+
+/*
+ * Minimal micro-benchmark harness shared by the physicslib benchmarks
+ *
+ * Each benchmark is a function running a batch of `opsPerCall` operations. The harness warms it up,
+ * calibrates the number of calls per sample so that a sample lasts at least `minSampleTime`,
+ * then times `repetitionCount` samples and reports ns/op statistics and the throughput.
+ * The results can be printed as a table or as JSON to compare runs and catch regressions.
+ */
+namespace benchmark
+{
+	struct Settings
+	{
+		std::size_t repetitionCount = 10;
+		std::chrono::nanoseconds warmUpTime = std::chrono::milliseconds(50);
+		std::chrono::nanoseconds minSampleTime = std::chrono::milliseconds(5);
+		std::string filter;      // Only the benchmarks whose name contains the filter are run
+		std::string jsonPath;    // "-" prints the JSON on stdout instead of the table
+	};
+
+	struct Result
+	{
+		std::string name;
+		std::size_t opsPerSample = 0;
+		double meanNs = 0;       // ns/op statistics over the samples
+		double medianNs = 0;
+		double minNs = 0;
+		double maxNs = 0;
+		double stddevNs = 0;
+
+		/**
+		 * Operations per second, computed from the median
+		 */
+		double getThroughput() const
+		{
+			return (medianNs > 0) ? 1e9 / medianNs : 0;
+		}
+	};
+
+	class Runner
+	{
+	public:
+		/**
+		 * Parse the command line options:
+		 * --repetitions N, --warmup-ms N, --sample-ms N, --filter TEXT, --json PATH ("-" for stdout)
+		 */
+		Runner(int argc, char* argv[])
+		{
+			for (int i = 1; i + 1 < argc; i += 2)
+			{
+				const std::string option = argv[i];
+				const char* value = argv[i + 1];
+				if (option == "--repetitions")
+				{
+					m_settings.repetitionCount = std::max<std::size_t>(1, std::strtoul(value, nullptr, 10));
+				}
+				else if (option == "--warmup-ms")
+				{
+					m_settings.warmUpTime = std::chrono::milliseconds(std::strtoul(value, nullptr, 10));
+				}
+				else if (option == "--sample-ms")
+				{
+					m_settings.minSampleTime = std::chrono::milliseconds(std::max<unsigned long>(1, std::strtoul(value, nullptr, 10)));
+				}
+				else if (option == "--filter")
+				{
+					m_settings.filter = value;
+				}
+				else if (option == "--json")
+				{
+					m_settings.jsonPath = value;
+				}
+				else
+				{
+					std::fprintf(stderr, "Unknown option %s\n", option.c_str());
+				}
+			}
+		}
+
+		/**
+		 * Add a context entry written in the JSON output (build mode, backend...)
+		 */
+		void addContext(const std::string& key, const std::string& value)
+		{
+			m_context.emplace_back(key, value);
+		}
+
+		/**
+		 * Time `function`, which runs `opsPerCall` operations per call
+		 */
+		void run(const std::string& name, std::size_t opsPerCall, const std::function<void()>& function)
+		{
+			if (!m_settings.filter.empty() && name.find(m_settings.filter) == std::string::npos)
+			{
+				return;
+			}
+
+			// Warm-up: fault in the buffers, settle the caches and the clock frequency
+			std::size_t callsPerSample = 0;
+			const auto warmUpStart = Clock::now();
+			do
+			{
+				function();
+				++callsPerSample;
+			} while (Clock::now() - warmUpStart < m_settings.warmUpTime);
+
+			// Calibration: grow the sample until it lasts long enough to be measured
+			callsPerSample = std::max<std::size_t>(1, callsPerSample / 4);
+			while (timeSample(function, callsPerSample) < m_settings.minSampleTime)
+			{
+				callsPerSample *= 2;
+			}
+
+			std::vector<double> samples(m_settings.repetitionCount);
+			for (double& sample : samples)
+			{
+				const double sampleNs = double(timeSample(function, callsPerSample).count());
+				sample = sampleNs / double(callsPerSample * opsPerCall);
+			}
+
+			m_results.push_back(computeStatistics(name, callsPerSample * opsPerCall, samples));
+			if (m_settings.jsonPath != "-")
+			{
+				printResult(m_results.back());
+			}
+		}
+
+		/**
+		 * Write the JSON report if requested, return the exit code of the benchmark
+		 */
+		int finish() const
+		{
+			if (m_settings.jsonPath.empty())
+			{
+				return 0;
+			}
+
+			FILE* file = (m_settings.jsonPath == "-") ? stdout : std::fopen(m_settings.jsonPath.c_str(), "w");
+			if (file == nullptr)
+			{
+				std::fprintf(stderr, "Cannot write %s\n", m_settings.jsonPath.c_str());
+				return 1;
+			}
+
+			writeJson(file);
+			if (file != stdout)
+			{
+				std::fclose(file);
+			}
+
+			return 0;
+		}
+
+		const std::vector<Result>& getResults() const { return m_results; }
+
+	private:
+		using Clock = std::chrono::steady_clock;
+
+		Settings m_settings;
+		std::vector<std::pair<std::string, std::string>> m_context;
+		std::vector<Result> m_results;
+
+		static std::chrono::nanoseconds timeSample(const std::function<void()>& function, std::size_t callCount)
+		{
+			const auto start = Clock::now();
+			for (std::size_t i = 0; i < callCount; ++i)
+			{
+				function();
+			}
+
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start);
+		}
+
+		static Result computeStatistics(const std::string& name, std::size_t opsPerSample, std::vector<double> samples)
+		{
+			Result result;
+			result.name = name;
+			result.opsPerSample = opsPerSample;
+
+			std::sort(samples.begin(), samples.end());
+			const std::size_t middle = samples.size() / 2;
+			result.medianNs = (samples.size() % 2 == 1) ? samples[middle] : (samples[middle - 1] + samples[middle]) / 2;
+			result.minNs = samples.front();
+			result.maxNs = samples.back();
+
+			for (double sample : samples)
+			{
+				result.meanNs += sample;
+			}
+			result.meanNs /= double(samples.size());
+
+			for (double sample : samples)
+			{
+				result.stddevNs += (sample - result.meanNs) * (sample - result.meanNs);
+			}
+			result.stddevNs = std::sqrt(result.stddevNs / double(samples.size()));
+
+			return result;
+		}
+
+		void printResult(const Result& result) const
+		{
+			if (m_results.size() == 1)
+			{
+				std::printf("%-36s %12s %12s %12s %10s %14s\n", "benchmark", "median ns/op", "min ns/op", "mean ns/op", "stddev", "Mops/s");
+			}
+			std::printf("%-36s %12.3f %12.3f %12.3f %9.1f%% %14.2f\n",
+				result.name.c_str(), result.medianNs, result.minNs, result.meanNs,
+				(result.meanNs > 0) ? 100 * result.stddevNs / result.meanNs : 0., result.getThroughput() / 1e6);
+		}
+
+		void writeJson(FILE* file) const
+		{
+			std::fprintf(file, "{\n  \"context\": {\n");
+			std::fprintf(file, "    \"repetitions\": %zu", m_settings.repetitionCount);
+			for (const auto& entry : m_context)
+			{
+				std::fprintf(file, ",\n    \"%s\": \"%s\"", entry.first.c_str(), entry.second.c_str());
+			}
+			std::fprintf(file, "\n  },\n  \"benchmarks\": [");
+			for (std::size_t i = 0; i < m_results.size(); ++i)
+			{
+				const Result& result = m_results[i];
+				std::fprintf(file, "%s\n    {\"name\": \"%s\", \"ops_per_sample\": %zu, "
+					"\"ns_per_op\": {\"median\": %.4f, \"mean\": %.4f, \"min\": %.4f, \"max\": %.4f, \"stddev\": %.4f}, "
+					"\"ops_per_second\": %.1f}",
+					(i == 0) ? "" : ",", result.name.c_str(), result.opsPerSample,
+					result.medianNs, result.meanNs, result.minNs, result.maxNs, result.stddevNs, result.getThroughput());
+			}
+			std::fprintf(file, "\n  ]\n}\n");
+		}
+	};
+}
@@ -0,0 +1,254 @@
+/*
+ * Broad phase benchmark of physicslib
+ *
+ * Scatters box-shaped rigid bodies in a volume which grows with their number, so that the density stays
+ * the same, then times each broad phase: the first update (building it from scratch), the updates of
+ * the following frames after the bodies moved, serially and on a WorkerPool of `threadCount` threads,
+ * and the search of the overlapping pairs. The numbers of pairs must be equal for all the broad phases.
+ * Three scenes are measured: bodies sliding on a floor and bodies drifting in a cube move a little at each
+ * frame (temporal coherence), while the random scene moves every body to a random place at each frame.
+ * Without a body count, the benchmark runs with 10k, 100k and 1M bodies.
+ *
+ * Usage: physicslib_bench_broadPhase_<real> [bodyCount] [stepCount] [threadCount]
+ */
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+#include "math/real.hpp"
+#include "math/simd.hpp"
+#include "math/vector3.hpp"
+#include "collisions/broadPhase.hpp"
+#include "rigidBody.hpp"
+#include "rigidBodyWorld.hpp"
+#include "workerPool.hpp"
+
+namespace
+{
+	const physicslib::real FRAME_TIME = physicslib::real(1) / 60;
+	const physicslib::real SPACING = 4; // Edge of the cube of space of each body
+
+	const physicslib::BroadPhaseType BROAD_PHASE_TYPES[] = {
+		physicslib::BroadPhaseType::OCTREE, physicslib::BroadPhaseType::LINEAR_OCTREE,
+		physicslib::BroadPhaseType::DYNAMIC_AABB_TREE, physicslib::BroadPhaseType::SWEEP_AND_PRUNE
+	};
+
+	enum class Scene
+	{
+		FLOOR, // Bodies sliding on a floor
+		CLOUD, // Bodies drifting in a cube
+		RANDOM // Bodies moved to a random place of a cube at each frame
+	};
+
+	const Scene SCENES[] = { Scene::FLOOR, Scene::CLOUD, Scene::RANDOM };
+
+	const char* getSceneName(Scene scene)
+	{
+		switch (scene)
+		{
+		case Scene::FLOOR:
+			return "floor";
+		case Scene::CLOUD:
+			return "cloud";
+		case Scene::RANDOM:
+			return "random";
+		}
+
+		return "unknown";
+	}
+
+	const char* getBroadPhaseName(physicslib::BroadPhaseType type)
+	{
+		switch (type)
+		{
+		case physicslib::BroadPhaseType::OCTREE:
+			return "octree";
+		case physicslib::BroadPhaseType::LINEAR_OCTREE:
+			return "linear octree";
+		case physicslib::BroadPhaseType::DYNAMIC_AABB_TREE:
+			return "AABB tree";
+		case physicslib::BroadPhaseType::SWEEP_AND_PRUNE:
+			return "sweep and prune";
+		}
+
+		return "unknown";
+	}
+
+	/**
+	 * Get the edge of the cube holding `bodyCount` bodies, centered on the origin
+	 */
+	physicslib::real getEdge(std::size_t bodyCount, Scene scene)
+	{
+		return (scene == Scene::FLOOR) ? SPACING * std::sqrt(physicslib::real(bodyCount)) : SPACING * std::cbrt(physicslib::real(bodyCount));
+	}
+
+	/**
+	 * Get the bounds of the space of the bodies: one layer on the floor of the cube, the whole cube otherwise
+	 */
+	physicslib::BoundingBox getBounds(std::size_t bodyCount, Scene scene)
+	{
+		const physicslib::real edge = getEdge(bodyCount, scene);
+		const physicslib::real height = (scene == Scene::FLOOR) ? 1 : edge;
+		return physicslib::BoundingBox { -edge / 2, -edge / 2, -edge / 2, edge, height, edge };
+	}
+
+	/**
+	 * Get a random point of `bounds`
+	 */
+	physicslib::Vector3 getRandomPoint(const physicslib::BoundingBox& bounds, std::mt19937& generator)
+	{
+		std::uniform_real_distribution<physicslib::real> unit(0, 1);
+		const physicslib::real x = bounds.x + bounds.width * unit(generator);
+		const physicslib::real y = bounds.y + bounds.height * unit(generator);
+		const physicslib::real z = bounds.z + bounds.depth * unit(generator);
+		return physicslib::Vector3(x, y, z);
+	}
+
+	physicslib::RigidBodyWorld createWorld(std::size_t bodyCount, Scene scene, std::mt19937& generator)
+	{
+		const physicslib::BoundingBox bounds = getBounds(bodyCount, scene);
+		std::uniform_real_distribution<physicslib::real> unit(0, 1);
+
+		physicslib::RigidBodyWorld world;
+		world.reserve(bodyCount);
+		for (std::size_t i = 0; i < bodyCount; ++i)
+		{
+			const physicslib::Vector3 boxSize(1 + unit(generator), 1 + unit(generator), 1 + unit(generator));
+			const physicslib::Vector3 position = getRandomPoint(bounds, generator);
+			const physicslib::real velocityY = (scene == Scene::FLOOR) ? 0 : 10 * unit(generator) - 5;
+			const physicslib::Vector3 velocity(10 * unit(generator) - 5, velocityY, 10 * unit(generator) - 5);
+			world.add(physicslib::RigidBody(1, 1, boxSize, position, velocity));
+		}
+
+		return world;
+	}
+
+	/**
+	 * Move the bodies of the scene by one frame
+	 */
+	void step(physicslib::RigidBodyWorld& world, Scene scene, const physicslib::BoundingBox& bounds, std::mt19937& generator)
+	{
+		world.integrate(FRAME_TIME);
+		if (scene == Scene::RANDOM)
+		{
+			for (std::size_t i = 0; i < world.getSize(); ++i)
+			{
+				world.setPosition(i, getRandomPoint(bounds, generator));
+			}
+		}
+	}
+
+	/**
+	 * Time one call of `function`, return the elapsed nanoseconds
+	 */
+	template <typename Function>
+	double measure(Function function)
+	{
+		const auto start = std::chrono::steady_clock::now();
+		function();
+		const auto end = std::chrono::steady_clock::now();
+
+		return std::chrono::duration<double, std::nano>(end - start).count();
+	}
+
+	struct Result
+	{
+		double buildNs = 0; // The first update
+		double updateNs = 0; // The following updates, in total
+		double pairsNs = 0; // The searches of the overlapping pairs, in total
+		std::size_t pairCount = 0; // After the last step
+	};
+
+	/**
+	 * Update a broad phase of type `type` for `stepCount` frames of the scene, with `workerPool` if it is not null
+	 * The pairs are only timed for the serial updates, the parallel updates only search them after the last step.
+	 */
+	Result run(physicslib::BroadPhaseType type, Scene scene, std::size_t bodyCount, std::size_t stepCount, physicslib::WorkerPool* workerPool)
+	{
+		std::mt19937 generator(42);
+		const physicslib::BoundingBox bounds = getBounds(bodyCount, scene);
+		physicslib::RigidBodyWorld world = createWorld(bodyCount, scene, generator);
+		const physicslib::real edge = getEdge(bodyCount, scene);
+		std::unique_ptr<physicslib::BroadPhase> broadPhase = physicslib::createBroadPhase(type, physicslib::BoundingBox { -edge / 2, -edge / 2, -edge / 2, edge, edge, edge });
+		std::vector<std::pair<physicslib::RigidBodyHandle, physicslib::RigidBodyHandle>> pairs;
+		const auto update = [&]()
+		{
+			if (workerPool != nullptr)
+			{
+				broadPhase->update(world, *workerPool);
+			}
+			else
+			{
+				broadPhase->update(world);
+			}
+		};
+
+		const auto searchPairs = [&]()
+		{
+			pairs.clear();
+			broadPhase->getOverlappingPairs(pairs);
+		};
+
+		Result result;
+		result.buildNs = measure(update);
+		for (std::size_t i = 0; i < stepCount; ++i)
+		{
+			step(world, scene, bounds, generator);
+			result.updateNs += measure(update);
+			if (workerPool == nullptr)
+			{
+				result.pairsNs += measure(searchPairs);
+			}
+		}
+
+		if (workerPool != nullptr)
+		{
+			searchPairs();
+		}
+		result.pairCount = pairs.size();
+
+		return result;
+	}
+
+	void runAll(std::size_t bodyCount, std::size_t stepCount, physicslib::WorkerPool& workerPool)
+	{
+		std::printf("real=%s simd=%s bodies=%zu steps=%zu threads=%zu\n", physicslib::getRealName(), physicslib::simd::getBackendName(), bodyCount, stepCount, workerPool.getThreadCount());
+		for (Scene scene : SCENES)
+		{
+			std::printf("  %s\n", getSceneName(scene));
+			for (physicslib::BroadPhaseType type : BROAD_PHASE_TYPES)
+			{
+				const Result serial = run(type, scene, bodyCount, stepCount, nullptr);
+				const Result parallel = run(type, scene, bodyCount, stepCount, &workerPool);
+				std::printf("    %-15s: build %.3f ms   update %.3f ms (serial)   %.3f ms (parallel)   pairs %.3f ms   %zu pairs%s\n",
+					getBroadPhaseName(type), serial.buildNs / 1e6, serial.updateNs / double(stepCount) / 1e6, parallel.updateNs / double(stepCount) / 1e6,
+					serial.pairsNs / double(stepCount) / 1e6, serial.pairCount, (serial.pairCount == parallel.pairCount) ? "" : " DIFFERENT");
+			}
+		}
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	const std::size_t stepCount = (argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 5;
+	const std::size_t threadCount = (argc > 3) ? std::strtoul(argv[3], nullptr, 10) : 0;
+	physicslib::WorkerPool workerPool(threadCount);
+
+	if (argc > 1)
+	{
+		runAll(std::strtoul(argv[1], nullptr, 10), stepCount, workerPool);
+	}
+	else
+	{
+		for (std::size_t bodyCount : { 10000, 100000, 1000000 })
+		{
+			runAll(bodyCount, stepCount, workerPool);
+		}
+	}
+
+	return 0;
+}
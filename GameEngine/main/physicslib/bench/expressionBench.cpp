@@ -0,0 +1,154 @@
+/*
+ * Expression template benchmark of physicslib
+ *
+ * Runs the contact and integration formulas of the library over arrays of vectors, once with
+ * the eager Vector3 operators and once with expression::lazy(), and reports the time per formula.
+ * The contact resolution of the library (ParticleContact::resolve) is measured as well.
+ *
+ * Usage: physicslib_bench_expression_<real> [count] [repetitionCount]
+ */
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include "collisions/particleContact.hpp"
+#include "math/expression.hpp"
+#include "math/real.hpp"
+#include "math/simd.hpp"
+#include "math/vector3.hpp"
+#include "particle.hpp"
+
+namespace
+{
+	const physicslib::real FRAME_TIME = physicslib::real(1) / 60;
+
+	/**
+	 * Run `function` `repetitionCount` times and return the time per call in nanoseconds
+	 */
+	template <typename Function>
+	double measure(std::size_t repetitionCount, Function function)
+	{
+		// Warm-up: fault in the buffers and settle the caches
+		function();
+
+		const auto start = std::chrono::steady_clock::now();
+		for (std::size_t i = 0; i < repetitionCount; ++i)
+		{
+			function();
+		}
+		const auto end = std::chrono::steady_clock::now();
+
+		return std::chrono::duration<double, std::nano>(end - start).count() / double(repetitionCount);
+	}
+
+	void report(const char* name, double eagerNs, double lazyNs, std::size_t count)
+	{
+		std::printf("  %-12s eager %7.2f ns/op   lazy %7.2f ns/op   speedup x%.2f\n",
+			name, eagerNs / double(count), lazyNs / double(count), eagerNs / lazyNs);
+	}
+
+	physicslib::Vector3 sum(const std::vector<physicslib::Vector3>& vectors)
+	{
+		physicslib::Vector3 total;
+		for (const physicslib::Vector3& vector : vectors)
+		{
+			total += vector;
+		}
+
+		return total;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	using physicslib::Vector3;
+	using physicslib::real;
+	namespace expression = physicslib::expression;
+
+	const std::size_t count = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 4096;
+	const std::size_t repetitionCount = (argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 2000;
+
+	std::vector<Vector3> positions(count);
+	std::vector<Vector3> velocities(count);
+	std::vector<Vector3> accelerations(count);
+	std::vector<Vector3> normals(count);
+	std::vector<real> penetrations(count);
+	std::vector<real> masses(count);
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		const real offset = real(i % 100);
+		positions[i] = Vector3(offset, 2 * offset, -offset);
+		velocities[i] = Vector3(1, offset / 10, 0);
+		accelerations[i] = Vector3(0, -10, offset / 100);
+		normals[i] = Vector3(offset, 1, 1).getNormalizedVector();
+		penetrations[i] = real(i % 7) / 10;
+		masses[i] = real(1 + i % 5);
+	}
+	std::vector<Vector3> results(count);
+
+	std::printf("real=%s simd=%s count=%zu repetitions=%zu\n", physicslib::getRealName(), physicslib::simd::getBackendName(), count, repetitionCount);
+
+	// Contact: p + n * pen * (m1 / (m1 + m2))
+	const double contactEager = measure(repetitionCount, [&]()
+	{
+		for (std::size_t i = 0; i + 1 < count; ++i)
+		{
+			results[i] = positions[i] + normals[i] * penetrations[i] * (masses[i + 1] / (masses[i] + masses[i + 1]));
+		}
+	});
+	const Vector3 contactEagerSum = sum(results);
+	const double contactLazy = measure(repetitionCount, [&]()
+	{
+		for (std::size_t i = 0; i + 1 < count; ++i)
+		{
+			results[i] = positions[i] + expression::lazy(normals[i]) * penetrations[i] * (masses[i + 1] / (masses[i] + masses[i + 1]));
+		}
+	});
+	report("contact", contactEager, contactLazy, count - 1);
+
+	// Integration: v = v + a * dt, p = p + v * dt
+	std::vector<Vector3> eagerVelocities(velocities);
+	std::vector<Vector3> eagerPositions(positions);
+	const double integrationEager = measure(repetitionCount, [&]()
+	{
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			eagerVelocities[i] = eagerVelocities[i] + accelerations[i] * FRAME_TIME;
+			eagerPositions[i] = eagerPositions[i] + eagerVelocities[i] * FRAME_TIME;
+		}
+	});
+	std::vector<Vector3> lazyVelocities(velocities);
+	std::vector<Vector3> lazyPositions(positions);
+	const double integrationLazy = measure(repetitionCount, [&]()
+	{
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			lazyVelocities[i] = lazyVelocities[i] + expression::lazy(accelerations[i]) * FRAME_TIME;
+			lazyPositions[i] = lazyPositions[i] + expression::lazy(lazyVelocities[i]) * FRAME_TIME;
+		}
+	});
+	report("integration", integrationEager, integrationLazy, count);
+
+	// Contact resolution of the library, which uses the lazy formulas
+	std::vector<physicslib::Particle> particles;
+	particles.reserve(count);
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		particles.emplace_back(1 / masses[i], positions[i], velocities[i]);
+	}
+	const double resolution = measure(repetitionCount, [&]()
+	{
+		for (std::size_t i = 0; i + 1 < count; i += 2)
+		{
+			physicslib::ParticleContact contact(&particles[i], &particles[i + 1], real(0.5), -1, penetrations[i], normals[i]);
+			contact.resolve(FRAME_TIME);
+		}
+	});
+	std::printf("  %-12s %7.2f ns/contact\n", "resolve", resolution / double(count / 2));
+
+	// The checksums keep the work observable, the lazy formulas must match the eager ones
+	std::printf("  checksums    contact %s / %s\n", contactEagerSum.toString().c_str(), sum(results).toString().c_str());
+	std::printf("               integration %s / %s\n", sum(eagerPositions).toString().c_str(), sum(lazyPositions).toString().c_str());
+
+	return 0;
+}
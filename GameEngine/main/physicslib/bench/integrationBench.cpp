@@ -0,0 +1,167 @@
+/*
+ * Integration benchmark of physicslib
+ *
+ * Steps a set of box-shaped rigid bodies (off-center forces, integration, render vertices)
+ * and reports the time per body and per step, once with an array of RigidBody objects and once
+ * with a RigidBodyWorld. The integration of the world alone is then timed serially and on a
+ * WorkerPool of `threadCount` threads, and serially with each integrator. The same source is built
+ * once with float and once with double so that both modes can be compared (see bench/CMakeLists.txt).
+ *
+ * Usage: physicslib_bench_integration_<real> [bodyCount] [stepCount] [threadCount]
+ */
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include "math/real.hpp"
+#include "math/simd.hpp"
+#include "math/vector3.hpp"
+#include "rigidBody.hpp"
+#include "rigidBodyWorld.hpp"
+#include "workerPool.hpp"
+
+namespace
+{
+	const physicslib::real FRAME_TIME = physicslib::real(1) / 60;
+
+	std::vector<physicslib::RigidBody> createBodies(std::size_t bodyCount)
+	{
+		std::vector<physicslib::RigidBody> bodies;
+		bodies.reserve(bodyCount);
+		for (std::size_t i = 0; i < bodyCount; ++i)
+		{
+			const physicslib::real offset = physicslib::real(i % 100);
+			bodies.emplace_back(
+				physicslib::real(1 + i % 7), physicslib::real(0.9), physicslib::Vector3(1, 2, 3),
+				physicslib::Vector3(offset, 2 * offset, 0), physicslib::Vector3(1, offset / 10, 0)
+			);
+		}
+
+		return bodies;
+	}
+
+	const physicslib::Vector3 GRAVITY(0, -10, 0);
+	const physicslib::Vector3 PUSH(0, 0, 1);
+	const physicslib::Vector3 BODY_POINT(physicslib::real(0.5), 1, physicslib::real(1.5));
+
+	/**
+	 * One frame of the game loop: forces, integration and render vertices
+	 */
+	void step(std::vector<physicslib::RigidBody>& bodies, std::vector<physicslib::Vector3>& vertices)
+	{
+		physicslib::Span<physicslib::Vector3> frameVertices(vertices);
+		for (std::size_t i = 0; i < bodies.size(); ++i)
+		{
+			bodies[i].addForceAtBodyPoint(GRAVITY, physicslib::Vector3());
+			bodies[i].addForceAtBodyPoint(PUSH, BODY_POINT);
+			bodies[i].integrate(FRAME_TIME);
+			bodies[i].getBoxVertices(frameVertices.subspan(i * physicslib::RigidBody::BOX_VERTEX_COUNT, physicslib::RigidBody::BOX_VERTEX_COUNT));
+		}
+	}
+
+	/**
+	 * The same frame on a RigidBodyWorld
+	 */
+	void step(physicslib::RigidBodyWorld& world, std::vector<physicslib::Vector3>& vertices)
+	{
+		for (std::size_t i = 0; i < world.getSize(); ++i)
+		{
+			world.addForceAtBodyPoint(i, GRAVITY, physicslib::Vector3());
+			world.addForceAtBodyPoint(i, PUSH, BODY_POINT);
+		}
+		world.integrate(FRAME_TIME);
+		world.getBoxVertices(vertices);
+	}
+
+	/**
+	 * Time `stepCount` calls of `function` after a warm-up call, return the elapsed nanoseconds
+	 */
+	template <typename Function>
+	double measure(std::size_t stepCount, Function function)
+	{
+		// Warm-up: fault in the buffers and settle the caches
+		function();
+
+		const auto start = std::chrono::steady_clock::now();
+		for (std::size_t i = 0; i < stepCount; ++i)
+		{
+			function();
+		}
+		const auto end = std::chrono::steady_clock::now();
+
+		return std::chrono::duration<double, std::nano>(end - start).count();
+	}
+
+	physicslib::RigidBodyWorld createWorld(std::size_t bodyCount)
+	{
+		physicslib::RigidBodyWorld world;
+		world.reserve(bodyCount);
+		for (const physicslib::RigidBody& body : createBodies(bodyCount))
+		{
+			world.add(body);
+		}
+
+		return world;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	const std::size_t bodyCount = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 10000;
+	const std::size_t stepCount = (argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 200;
+	const std::size_t threadCount = (argc > 3) ? std::strtoul(argv[3], nullptr, 10) : 0;
+
+	std::vector<physicslib::RigidBody> bodies = createBodies(bodyCount);
+	std::vector<physicslib::Vector3> vertices(bodyCount * physicslib::RigidBody::BOX_VERTEX_COUNT);
+	const double objectsNs = measure(stepCount, [&]() { step(bodies, vertices); });
+
+	physicslib::RigidBodyWorld world = createWorld(bodyCount);
+	const double worldNs = measure(stepCount, [&]() { step(world, vertices); });
+
+	// Integration alone, the torques of the first step make every body turn
+	physicslib::WorkerPool workerPool(threadCount);
+	physicslib::RigidBodyWorld serialWorld = createWorld(bodyCount);
+	physicslib::RigidBodyWorld parallelWorld = createWorld(bodyCount);
+	step(serialWorld, vertices);
+	step(parallelWorld, vertices);
+	const double serialNs = measure(stepCount, [&]() { serialWorld.integrate(FRAME_TIME); });
+	const double parallelNs = measure(stepCount, [&]() { parallelWorld.integrate(FRAME_TIME, workerPool); });
+	const bool isIdentical = std::memcmp(serialWorld.getPositions().data(), parallelWorld.getPositions().data(), bodyCount * sizeof(physicslib::Vector3)) == 0
+		&& std::memcmp(serialWorld.getOrientations().data(), parallelWorld.getOrientations().data(), bodyCount * sizeof(physicslib::Quaternion)) == 0;
+
+	// Cost of each integrator, to weigh against the larger steps the higher orders allow
+	const physicslib::Integrator integrators[] = { physicslib::Integrator::SEMI_IMPLICIT_EULER, physicslib::Integrator::VELOCITY_VERLET, physicslib::Integrator::RUNGE_KUTTA_4 };
+	double integratorNs[3];
+	for (std::size_t i = 0; i < 3; ++i)
+	{
+		physicslib::RigidBodyWorld integratorWorld = createWorld(bodyCount);
+		integratorWorld.setIntegrator(integrators[i]);
+		step(integratorWorld, vertices);
+		integratorNs[i] = measure(stepCount, [&]() { integratorWorld.integrate(FRAME_TIME); });
+	}
+
+	// The checksums keep the work observable and show the precision drift between the modes
+	physicslib::Vector3 objectsChecksum;
+	physicslib::Vector3 worldChecksum;
+	for (std::size_t i = 0; i < bodyCount; ++i)
+	{
+		objectsChecksum += bodies[i].getPosition();
+		worldChecksum += world.getPosition(i);
+	}
+
+	const double bodySteps = double(bodyCount) * double(stepCount);
+	std::printf("real=%s simd=%s bodies=%zu steps=%zu\n", physicslib::getRealName(), physicslib::simd::getBackendName(), bodyCount, stepCount);
+	std::printf("  body size      : %zu bytes\n", sizeof(physicslib::RigidBody));
+	std::printf("  vertex buffer  : %zu bytes\n", vertices.size() * sizeof(physicslib::Vector3));
+	std::printf("  time per step  : %.3f ms (objects)   %.3f ms (world)\n", objectsNs / double(stepCount) / 1e6, worldNs / double(stepCount) / 1e6);
+	std::printf("  ns / body-step : %.2f (objects)   %.2f (world)\n", objectsNs / bodySteps, worldNs / bodySteps);
+	std::printf("  checksum       : %s / %s\n", objectsChecksum.toString().c_str(), worldChecksum.toString().c_str());
+	std::printf("  integrate      : %.3f ms (serial)   %.3f ms (%zu threads)   speedup x%.2f   %s\n",
+		serialNs / double(stepCount) / 1e6, parallelNs / double(stepCount) / 1e6, workerPool.getThreadCount(),
+		serialNs / parallelNs, isIdentical ? "identical" : "DIFFERENT");
+	std::printf("  integrators    : %.3f ms (semi-implicit Euler)   %.3f ms (velocity Verlet)   %.3f ms (RK4)\n",
+		integratorNs[0] / double(stepCount) / 1e6, integratorNs[1] / double(stepCount) / 1e6, integratorNs[2] / double(stepCount) / 1e6);
+
+	return 0;
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "math/matrix3.hpp"
+#include "math/vector3.hpp"
+#include "span.hpp"
+
+namespace physicslib
+{
+	/**
+	 * Shape shared by rigid bodies
+	 *
+	 * Everything about a body which only depends on its shape is computed once when the shape is built:
+	 * the inverse inertia tensor of a unit mass (a body of inverse mass m gets this tensor scaled by m),
+	 * the local bounds and the vertices drawing it. The bounds are the smallest box centered on the center
+	 * of mass which encloses the shape, the vertices are the triangles of this box.
+	 * Shapes are immutable, bodies refer to them through a CollisionShapeRegistry.
+	 *
+	 * Meshes and convex hulls are solids of uniform density with exact mass properties. Their vertices keep
+	 * their own coordinates: the center of mass of a body of such a shape is at getCenterOfMass() in them.
+	 */
+	class CollisionShape
+	{
+	public:
+		static const std::size_t BOX_VERTEX_COUNT = 36; // The number of vertices of the triangles drawing the box
+
+		/**
+		 * Create a box of size `boxSize`
+		 */
+		static CollisionShape createBox(const Vector3& boxSize);
+
+		/**
+		 * Create a cloud of points of equal masses, the coordinates are relative to the center of mass
+		 */
+		static CollisionShape createPointCloud(const std::vector<Vector3>& points);
+
+		/**
+		 * Create the solid bounded by a closed triangle mesh
+		 * `indices` holds 3 vertex indices per triangle, in counterclockwise order seen from outside.
+		 */
+		static CollisionShape createMesh(const std::vector<Vector3>& vertices, const std::vector<std::uint32_t>& indices);
+
+		/**
+		 * Create the solid convex hull of `points`
+		 * Points which are all on a plane have no volume: they make a point cloud instead.
+		 */
+		static CollisionShape createConvexHull(const std::vector<Vector3>& points);
+
+		/**
+		 * Get the inverse inertia tensor of a box of size `boxSize` and of unit mass
+		 */
+		static Matrix3 getBoxInverseInertiaTensor(const Vector3& boxSize);
+
+		/**
+		 * Get the vertices of the triangles of a box of size `boxSize`, centered on the origin
+		 */
+		static std::array<Vector3, BOX_VERTEX_COUNT> getBoxLocalVertices(const Vector3& boxSize);
+
+		/**
+		 * Get the local inverse inertia tensor of a body of this shape
+		 */
+		Matrix3 getLocalInverseInertiaTensor(real inverseMass) const;
+
+		#pragma region Getters
+
+		const Matrix3& getInverseInertiaTensor() const;
+		const Vector3& getBoxSize() const;
+		const Vector3& getCenterOfMass() const;
+		real getVolume() const;
+		Span<const Vector3> getVertices() const;
+
+		#pragma endregion
+
+	private:
+		Matrix3 m_inverseInertiaTensor; // Inverse inertia tensor of a unit mass
+		Vector3 m_boxSize; // Size of the local bounds
+		Vector3 m_centerOfMass; // In the coordinates the shape was built from
+		real m_volume; // Zero for point clouds
+		std::array<Vector3, BOX_VERTEX_COUNT> m_vertices; // Local vertices of the local bounds
+
+		/**
+		 * Constructor
+		 */
+		CollisionShape(const Matrix3& inverseInertiaTensor, const Vector3& boxSize, const Vector3& centerOfMass = Vector3(), real volume = 0);
+	};
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <map>
+#include <vector>
+#include "collisionShape.hpp"
+
+namespace physicslib
+{
+	using CollisionShapeId = std::uint32_t;
+
+	/**
+	 * Owner of the collision shapes, which bodies refer to by id
+	 *
+	 * A shape is built once and shared by all the bodies using it, whatever their number:
+	 * spawning a body only copies an id, and the data of the shape is stored once.
+	 * Boxes of the same size share one shape. The ids stay valid as long as the registry.
+	 */
+	class CollisionShapeRegistry
+	{
+	public:
+		/**
+		 * Constructor
+		 */
+		CollisionShapeRegistry() = default;
+
+		/**
+		 * Get the id of the box of size `boxSize`, the shape is created on first use
+		 */
+		CollisionShapeId addBox(const Vector3& boxSize);
+
+		/**
+		 * Add a shape, return its id
+		 */
+		CollisionShapeId add(const CollisionShape& shape);
+
+		/**
+		 * Get the shape of a valid id
+		 * The reference is invalidated by the next addition.
+		 */
+		const CollisionShape& get(CollisionShapeId id) const;
+
+		/**
+		 * Get the number of shapes
+		 */
+		std::size_t getSize() const;
+
+	private:
+		std::vector<CollisionShape> m_shapes;
+		std::map<std::array<real, 3>, CollisionShapeId> m_boxes; // Id of the box shape of each size
+	};
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <algorithm>
+
+#include "math/real.hpp"
+
+namespace physicslib
+{
+	// Struc used to give bounds to an octree, or to an object in it
+	struct BoundingBox
+	{
+		// x, y, z represent the bottom left point of the box
+		real x;
+		real y;
+		real z;
+		real width;
+		real height;
+		real depth;
+
+		// Return if `anotherBox` is entirely inside this box.
+		bool contains(const BoundingBox& anotherBox) const
+		{
+			return anotherBox.x >= x && anotherBox.x + anotherBox.width <= x + width
+				&& anotherBox.y >= y && anotherBox.y + anotherBox.height <= y + height
+				&& anotherBox.z >= z && anotherBox.z + anotherBox.depth <= z + depth;
+		}
+
+		// Return if `anotherBox` and this box intersect, touching boxes intersect.
+		bool overlaps(const BoundingBox& anotherBox) const
+		{
+			return anotherBox.x <= x + width && x <= anotherBox.x + anotherBox.width
+				&& anotherBox.y <= y + height && y <= anotherBox.y + anotherBox.height
+				&& anotherBox.z <= z + depth && z <= anotherBox.z + anotherBox.depth;
+		}
+
+		// Return the smallest box containing this box and `anotherBox`.
+		BoundingBox merge(const BoundingBox& anotherBox) const
+		{
+			const real minX = std::min(x, anotherBox.x);
+			const real minY = std::min(y, anotherBox.y);
+			const real minZ = std::min(z, anotherBox.z);
+			return BoundingBox {
+				minX, minY, minZ,
+				std::max(x + width, anotherBox.x + anotherBox.width) - minX,
+				std::max(y + height, anotherBox.y + anotherBox.height) - minY,
+				std::max(z + depth, anotherBox.z + anotherBox.depth) - minZ
+			};
+		}
+
+		// Return the area of the surface of the box.
+		real getSurfaceArea() const
+		{
+			return 2 * (width * height + height * depth + depth * width);
+		}
+	};
+}
@@ -1,7 +1,9 @@
 #pragma once
 
+#include "collisions/boundingBox.hpp"
 #include "collisions/primitive.hpp"
 #include "math/vector3.hpp"
+#include "span.hpp"
 
 namespace physicslib
 {
@@ -13,6 +15,12 @@ namespace physicslib
 		 */
 		BoxPrimitive(std::shared_ptr<RigidBody> rigidBody);
 
+		/**
+		 * Constructor
+		 * Create the box of size `boxSize` placed by `transformMatrix`, used for the bodies of a RigidBodyWorld
+		 */
+		BoxPrimitive(const Matrix34& transformMatrix, const Vector3& boxSize);
+
 		/**
 		 * Default copy constructor
 		 */
@@ -28,11 +36,29 @@ namespace physicslib
 		 */
 		BoxPrimitive& operator=(const BoxPrimitive& anotherBoxPrimitive) = default;
 
+		static const std::size_t VERTEX_COUNT = 8; // The number of vertices of a box
+
 		/**
 		 * Get the vertices of the corresponding box rigidBody
 		 */
 		virtual std::vector<Vector3> getVertices() const;
 
+		/**
+		 * Get the number of vertices of a box
+		 */
+		std::size_t getVertexCount() const override;
+
+		/**
+		 * Write the vertices of the corresponding box rigidBody in `vertices`
+		 * `vertices` must hold VERTEX_COUNT points
+		 */
+		void getVertices(Span<Vector3> vertices) const override;
+
+		/**
+		 * Get the smallest axis-aligned box containing the box
+		 */
+		BoundingBox getBoundingBox() const;
+
 	private:
 		Vector3 m_halfSizes;
 	};
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "boundingBox.hpp"
+#include "rigidBodyWorld.hpp"
+#include "workerPool.hpp"
+
+namespace physicslib
+{
+	/**
+	 * Structures of the broad phase, see createBroadPhase()
+	 */
+	enum class BroadPhaseType
+	{
+		OCTREE, // Loose octree updated incrementally, for scenes where few bodies move
+		LINEAR_OCTREE, // Octree of the Morton codes of the bodies rebuilt every frame, in parallel
+		DYNAMIC_AABB_TREE, // Bounding volume hierarchy of fat bounds updated incrementally, for the pairs of many moving bodies
+		SWEEP_AND_PRUNE // Bodies sorted along one axis and kept sorted by insertion, for the pairs of coherent scenes
+	};
+
+	/**
+	 * Broad phase of the collision detection
+	 *
+	 * Finds the bodies of a RigidBodyWorld whose bounds overlap, from the axis-aligned bounding boxes of their boxes.
+	 * update() brings the structure up to date with the world, the queries then describe the world of the last update.
+	 */
+	class BroadPhase
+	{
+	public:
+		/**
+		 * Virtual destructor
+		 */
+		virtual ~BroadPhase() = default;
+
+		/**
+		 * Bring the structure up to date with the bodies of `world`
+		 */
+		virtual void update(const RigidBodyWorld& world) = 0;
+
+		/**
+		 * Same as update(world), parallelized on `workerPool` by the structures which can be
+		 * The default implementation is the serial update.
+		 */
+		virtual void update(const RigidBodyWorld& world, WorkerPool& workerPool);
+
+		/**
+		 * Add the bodies whose bounds overlap `bounds` to `result`
+		 */
+		virtual void query(const BoundingBox& bounds, std::vector<RigidBodyHandle>& result) const = 0;
+
+		/**
+		 * Add the pairs of bodies whose bounds overlap to `pairs`, each pair once
+		 */
+		virtual void getOverlappingPairs(std::vector<std::pair<RigidBodyHandle, RigidBodyHandle>>& pairs) const = 0;
+
+		/**
+		 * Get the bounds of the body at `index` of `world`
+		 */
+		static BoundingBox getBoundingBox(const RigidBodyWorld& world, std::size_t index);
+	};
+
+	/**
+	 * Create a broad phase of type `type` for bodies which are mostly inside `bounds`
+	 */
+	std::unique_ptr<BroadPhase> createBroadPhase(BroadPhaseType type, const BoundingBox& bounds);
+}
@@ -10,7 +10,7 @@ namespace physicslib
 		/**
 		 * Constructor
 		 */
-		Contact(const Vector3& contactPoint, const Vector3& contactNormal, double penetration);
+		Contact(const Vector3& contactPoint, const Vector3& contactNormal, real penetration);
 
 		/**
 		 * Default copy constructor
@@ -35,6 +35,6 @@ namespace physicslib
 	private:
 		Vector3 m_contactPoint;
 		Vector3 m_contactNormal;
-		double m_penetration;
+		real m_penetration;
 	};
 }
\ No newline at end of file
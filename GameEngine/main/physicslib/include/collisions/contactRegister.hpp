@@ -13,7 +13,7 @@ namespace physicslib
 		void add(ParticleContact& contact);
 		void clear();
 
-		void resolveContacts(double frametime);
+		void resolveContacts(real frametime);
 	private:
 		std::vector<ParticleContact> m_register;
 	};
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "broadPhase.hpp"
+
+namespace physicslib
+{
+	/**
+	 * Bounding volume hierarchy of the bodies, kept across the updates
+	 *
+	 * Each body is a leaf whose fat bounds are the bounds of the body grown by `margin` on every side. A leaf only
+	 * moves in the tree when its body leaves its fat bounds: a body moving slowly is reinserted every few frames,
+	 * a sleeping body never. The inner nodes are the union of the fat bounds of their two children.
+	 * A leaf is inserted next to the sibling which minimizes the surface area of the tree (surface area heuristic),
+	 * searched by descending the tree along the cheapest lower bound of the cost. The ancestors of the inserted leaf
+	 * are then rotated, swapping a child and a grandchild when it reduces the area of the inner node, to undo the
+	 * degradation of successive insertions.
+	 * The pairs are found by descending the tree against itself, each pair is visited once: on a tree of
+	 * logarithmic height, the search costs about O(n log n).
+	 * The queries and the pairs test the exact bounds of the bodies, the fat bounds only prune the descent.
+	 */
+	class DynamicAabbTree : public BroadPhase
+	{
+	public:
+		static constexpr real DEFAULT_MARGIN = real(0.2);
+
+		/**
+		 * Constructor
+		 */
+		explicit DynamicAabbTree(real margin = DEFAULT_MARGIN);
+
+		using BroadPhase::update;
+		void update(const RigidBodyWorld& world) override;
+		void query(const BoundingBox& bounds, std::vector<RigidBodyHandle>& result) const override;
+		void getOverlappingPairs(std::vector<std::pair<RigidBodyHandle, RigidBodyHandle>>& pairs) const override;
+
+		/**
+		 * Get the number of leaves, one per body
+		 */
+		std::size_t getLeafCount() const;
+
+		/**
+		 * Get the number of levels of the tree, 0 when it is empty
+		 */
+		std::size_t getHeight() const;
+
+		/**
+		 * Get the sum of the surface areas of the inner nodes, the cost the insertions minimize
+		 */
+		real getSurfaceAreaCost() const;
+
+	private:
+		static constexpr std::uint32_t INVALID_NODE = UINT32_MAX;
+
+		struct Node
+		{
+			BoundingBox bounds; // The fat bounds of a leaf, the union of the bounds of the children of an inner node
+			BoundingBox bodyBounds; // The exact bounds of the body of a leaf
+			std::uint32_t parent; // INVALID_NODE for the root, the next free node for a free node
+			std::uint32_t children[2]; // INVALID_NODE for a leaf
+			RigidBodyHandle body;
+
+			bool isLeaf() const
+			{
+				return children[0] == INVALID_NODE;
+			}
+		};
+
+		const real m_margin;
+		std::vector<Node> m_nodes;
+		std::uint32_t m_root = INVALID_NODE;
+		std::uint32_t m_freeNode = INVALID_NODE; // The first of the list of the free nodes
+		std::size_t m_leafCount = 0;
+		std::vector<std::uint32_t> m_bodyLeaves; // The leaf of the body of each slot of the world, INVALID_NODE if it has none
+
+		// Traversal data, kept to reuse its memory
+		mutable std::vector<std::uint32_t> m_stack;
+		mutable std::vector<std::pair<std::uint32_t, std::uint32_t>> m_pairStack;
+
+		/**
+		 * Get a free node, its memory is reused when possible
+		 */
+		std::uint32_t allocateNode();
+
+		/**
+		 * Add a node to the free nodes
+		 */
+		void freeNode(std::uint32_t node);
+
+		/**
+		 * Get the bounds of `bodyBounds` grown by the margin
+		 */
+		BoundingBox getFatBounds(const BoundingBox& bodyBounds) const;
+
+		/**
+		 * Insert a leaf of the body `body` and return it
+		 */
+		std::uint32_t insertLeaf(const BoundingBox& bodyBounds, RigidBodyHandle body);
+
+		/**
+		 * Insert an allocated leaf in the tree
+		 */
+		void insertLeaf(std::uint32_t leaf);
+
+		/**
+		 * Remove a leaf from the tree without freeing it
+		 */
+		void removeLeaf(std::uint32_t leaf);
+
+		/**
+		 * Get the best sibling of a new leaf of bounds `bounds` according to the surface area heuristic
+		 */
+		std::uint32_t findBestSibling(const BoundingBox& bounds) const;
+
+		/**
+		 * Recompute the bounds of `node` and its ancestors, rotating them if `rotate` is true
+		 */
+		void refit(std::uint32_t node, bool rotate);
+
+		/**
+		 * Swap a child and a grandchild of the inner node `node` if it reduces the surface area of the tree
+		 */
+		void rotate(std::uint32_t node);
+
+		/**
+		 * Replace the child `child` of `parent` by `newChild`
+		 */
+		void replaceChild(std::uint32_t parent, std::uint32_t child, std::uint32_t newChild);
+	};
+}
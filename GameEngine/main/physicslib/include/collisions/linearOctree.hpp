@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "broadPhase.hpp"
+
+namespace physicslib
+{
+	/**
+	 * Octree stored as a flat array of nodes, rebuilt from the Morton codes of the bodies at each update
+	 *
+	 * The centers of the bodies are quantized on a grid of 2^MORTON_BITS_BY_AXIS cells per axis over the bounds
+	 * of the octree, and their Morton codes interleave the bits of the cell coordinates: sorted by code, the
+	 * bodies of any octree node are contiguous. The build sorts the codes with a radix sort, then cuts the sorted
+	 * range in nodes, breadth first, until a node holds at most `maxBodiesByLeaf` bodies.
+	 * The nodes and the bodies are arrays read linearly; a node keeps the union of the bounds of its bodies,
+	 * which the queries test before visiting its children. The bodies outside the bounds are clamped to the
+	 * border cells: they are still found, only less efficiently.
+	 *
+	 * The update with a WorkerPool computes the codes, sorts them and computes the bounds of the leaves in parallel,
+	 * its result is identical to the serial update.
+	 */
+	class LinearOctree : public BroadPhase
+	{
+	public:
+		static const unsigned int MORTON_BITS_BY_AXIS = 10; // The depth of the octree, codes fit in 32 bits
+		static const std::size_t DEFAULT_MAX_BODIES_BY_LEAF = 8;
+		static const std::size_t CHUNK_SIZE = 4096; // Number of bodies processed by a worker at a time
+
+		/**
+		 * Constructor
+		 */
+		LinearOctree(const BoundingBox& bounds, std::size_t maxBodiesByLeaf = DEFAULT_MAX_BODIES_BY_LEAF);
+
+		void update(const RigidBodyWorld& world) override;
+		void update(const RigidBodyWorld& world, WorkerPool& workerPool) override;
+		void query(const BoundingBox& bounds, std::vector<RigidBodyHandle>& result) const override;
+		void getOverlappingPairs(std::vector<std::pair<RigidBodyHandle, RigidBodyHandle>>& pairs) const override;
+
+		/**
+		 * Get the number of nodes
+		 */
+		std::size_t getNodeCount() const;
+
+		/**
+		 * Get the Morton code of the cell (x, y, z), each coordinate in [0, 2^MORTON_BITS_BY_AXIS[
+		 */
+		static std::uint32_t getMortonCode(std::uint32_t x, std::uint32_t y, std::uint32_t z);
+
+	private:
+		static const std::uint32_t RADIX_BITS = 8; // Bits sorted by each pass of the radix sort
+		static const std::uint32_t RADIX_SIZE = 1 << RADIX_BITS;
+
+		struct Node
+		{
+			BoundingBox bounds; // The union of the bounds of the bodies of the node
+			std::uint32_t begin; // The bodies of the node are [begin, end[ in the sorted bodies
+			std::uint32_t end;
+			std::uint32_t firstChild; // The children are consecutive
+			std::uint32_t childCount; // 0 for a leaf
+		};
+
+		const BoundingBox m_bounds;
+		const std::size_t m_maxBodiesByLeaf;
+		std::vector<Node> m_nodes; // Breadth first, the root first
+
+		// Bodies sorted by Morton code
+		std::vector<std::uint32_t> m_codes;
+		std::vector<std::uint32_t> m_indices; // Index of each body in the world
+		std::vector<BoundingBox> m_sortedBounds;
+		std::vector<RigidBodyHandle> m_sortedBodies;
+
+		// Build data, kept to reuse its memory
+		std::vector<BoundingBox> m_bodyBounds; // Bounds of the bodies in the order of the world
+		std::vector<std::uint32_t> m_sortCodes;
+		std::vector<std::uint32_t> m_sortIndices;
+		std::vector<std::uint32_t> m_histograms; // RADIX_SIZE counters per partition
+		mutable std::vector<std::uint32_t> m_stack; // The nodes left to visit by a query
+
+		/**
+		 * Rebuild the octree, with the loops run by `workerPool` if it is not null
+		 */
+		void build(const RigidBodyWorld& world, WorkerPool* workerPool);
+
+		/**
+		 * Sort m_codes and m_indices by code
+		 * The bodies are cut in `partitionCount` contiguous partitions, which count and scatter their keys in parallel.
+		 */
+		void sort(std::size_t partitionCount, WorkerPool* workerPool);
+
+		/**
+		 * Visit the nodes overlapping `bounds`, call `function(sortedIndex)` for each body overlapping it
+		 */
+		template <typename Function>
+		void visit(const BoundingBox& bounds, const Function& function) const;
+	};
+}
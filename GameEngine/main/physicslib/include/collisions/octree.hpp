@@ -1,41 +1,74 @@
 #pragma once
 
+#include <cstdint>
 #include <vector>
 #include <memory>
 #include <algorithm>
 
+#include "boundingBox.hpp"
 #include "planePrimitive.hpp"
+#include "rigidBodyWorld.hpp"
 
 namespace physicslib
 {
-	// Struc used to give bounds to an octree
-	struct BoundingBox
+	// Struct used to configure an octree
+	struct OctreeConfiguration
 	{
-		// x, y, z represent the bottom left point of the octree
-		double x;
-		double y;
-		double z;
-		double width;
-		double height;
-		double depth;
+		unsigned int maxEntriesByNode = 8; // The number of entries over which a leaf is split
+		unsigned int minEntriesByNode = 4; // The number of entries under which a subtree is collapsed, less than maxEntriesByNode
+		unsigned int maxLevels = 8; // The maximum number of level
+		real looseness = 2; // The size of the loose bounds of a node relative to its bounds, 1 for a strict octree
 	};
 
+	// Loose octree of persistent entries, each entry is the bounding box of a body.
+	// A node accepts the entries whose center is inside its bounds and which fit in its loose bounds, its bounds
+	// scaled by the looseness around their center: with the default looseness of 2, a box goes as deep as the nodes
+	// at least as large as it, whatever its position. An entry lives in the deepest node accepting it and stays there
+	// while it moves inside its loose bounds: updating an entry only moves it in the tree when it leaves them,
+	// so a frame costs the number of entries which changed cell rather than the number of entries.
+	// A leaf holding too many entries is split, a node whose subtree holds too few entries is collapsed.
+	// The entries outside the bounds of the octree are kept in the root.
 	class Octree
 	{
 	public:
+		using Handle = std::uint32_t; // Identifier of an entry, reused after the entry is removed
+		static constexpr Handle INVALID_HANDLE = UINT32_MAX;
+
 		// Constructor
-		Octree(const unsigned int pLevel, const BoundingBox& pBounds);
+		Octree(const unsigned int pLevel, const BoundingBox& pBounds, const OctreeConfiguration& configuration = OctreeConfiguration());
 
 		// Function used to clear the octree.
-		// Clean all the points and remove the subdivisions.
+		// Remove all the entries and the subdivisions, their handles become invalid.
+		// The memory of the entries and of the nodes is kept to be reused by the next insertions.
 		void clear();
 
-		// Insert an object in the octree.
-		// It first cut the object in points and then add each point to the octree.
-		void insert(std::shared_ptr<Primitive> body);
+		// Insert the entry of `body` in the octree and return its handle.
+		Handle insert(const BoundingBox& bounds, RigidBodyHandle body = RigidBodyHandle());
+
+		// Change the bounds of an entry.
+		// The entry only moves in the tree if it is not entirely inside its node any more.
+		void update(Handle handle, const BoundingBox& newBounds);
+
+		// Remove an entry, the nodes left with too few entries are collapsed.
+		void remove(Handle handle);
+
+		// Get the bounds of an entry.
+		const BoundingBox& getBounds(Handle handle) const;
+
+		// Get the body of an entry.
+		RigidBodyHandle getBody(Handle handle) const;
 
-		// Get the list of all the points that are next to a plane associated with that plane.
-		void retrieve(std::vector<std::pair<Vector3, const PlanePrimitive * >>& collisions, bool top, bool right, bool bottom, bool left) const;
+		// Get the number of entries.
+		std::size_t getSize() const;
+
+		// Get the list of all the entries that are next to a plane associated with that plane.
+		void retrieve(std::vector<std::pair<Handle, const PlanePrimitive * >>& collisions, bool top, bool right, bool bottom, bool left) const;
+
+		// Get the list of all the entries whose bounds overlap `bounds`.
+		void query(const BoundingBox& bounds, std::vector<Handle>& result) const;
+
+		// Get the list of all the pairs of entries whose bounds overlap, each pair once.
+		void getOverlappingPairs(std::vector<std::pair<Handle, Handle>>& pairs) const;
 
 		// Return if the octree has nodes.
 		bool hasNodes() const;
@@ -47,25 +80,70 @@ namespace physicslib
 		static void setLeftPlane(const PlanePrimitive * const leftPlane);
 
 	private:
-		static const unsigned int MAX_RIGIDBODY_BY_LEVEL = 1; // The maximum number of points by subdivision level
-		static const unsigned int MAX_LEVELS = 8; // The maximum number of level
+		static constexpr std::uint32_t INVALID_NODE = UINT32_MAX;
 		static const PlanePrimitive * m_topPlane;
 		static const PlanePrimitive * m_bottomPlane;
 		static const PlanePrimitive * m_leftPlane;
 		static const PlanePrimitive * m_rightPlane;
 
-		const unsigned int m_level; // The level of this octree
-		const BoundingBox m_bounds; // The bounds of the octree
-		std::vector<Vector3> m_points; // The points contained by the octree
-		std::vector<Octree> m_nodes; // The subdivision nodes of the octree
+		struct Node
+		{
+			BoundingBox bounds; // The bounds of the node
+			BoundingBox looseBounds; // The bounds of the entries of the node
+			unsigned int level; // The level of the node
+			std::uint32_t parent; // INVALID_NODE for the root
+			std::uint32_t firstChild; // The 8 children are consecutive, INVALID_NODE for a leaf
+			std::uint32_t subtreeSize; // The number of entries in the node and its children
+			std::vector<Handle> entries; // The entries stored in the node
+		};
+
+		struct Entry
+		{
+			BoundingBox bounds;
+			RigidBodyHandle body;
+			std::uint32_t node; // INVALID_NODE when the entry is free
+			std::uint32_t position; // Index of the entry in the entries of its node
+		};
+
+		const OctreeConfiguration m_configuration;
+		std::vector<Node> m_nodes; // The nodes of the octree, the root first
+		std::vector<std::uint32_t> m_freeChildren; // The first nodes of the freed groups of children, reused by the next splits
+		std::vector<Entry> m_entries;
+		std::vector<Handle> m_freeEntries;
+		std::size_t m_size = 0;
+		mutable std::vector<Handle> m_overlappingEntries; // The result of the queries of getOverlappingPairs(), kept to reuse its memory
+
+		// Split a leaf in 8
+		void split(std::uint32_t node);
+
+		// Move all the entries of the subtree of `node` to `node` and free its children
+		void collapse(std::uint32_t node);
+
+		// Return the index of the child of `node` in which the given point should be.
+		int getIndex(std::uint32_t node, Vector3 point) const;
+
+		// Return the loose bounds of a node of bounds `bounds`
+		BoundingBox getLooseBounds(const BoundingBox& bounds) const;
+
+		// Return the child of `node` which accepts `bounds`, INVALID_NODE if there is none.
+		std::uint32_t getChild(std::uint32_t node, const BoundingBox& bounds) const;
+
+		// Return if `node` accepts an entry of bounds `bounds`: its center is inside the node and it fits in its loose bounds.
+		bool accepts(std::uint32_t node, const BoundingBox& bounds) const;
+
+		// Insert an entry in the subtree of `node`
+		void insert(std::uint32_t node, Handle handle);
+
+		// Remove an entry from its node, without collapsing
+		void detach(Handle handle);
 
-		// Split the octree in 8
-		void split();
+		// Collapse the highest of `node` and its ancestors left with too few entries
+		void collapseFrom(std::uint32_t node);
 
-		// Return the index of the node in which the given point should be.
-		int getIndex(Vector3 point) const;
+		// Add the entries of the subtree of `node` overlapping `bounds`
+		void query(std::uint32_t node, const BoundingBox& bounds, std::vector<Handle>& result) const;
 
-		// Insert the point iin the octree.
-		void insert(Vector3 point);
+		// Add the entries of the subtree of `node` next to the planes
+		void retrieve(std::uint32_t node, std::vector<std::pair<Handle, const PlanePrimitive * >>& collisions, bool top, bool right, bool bottom, bool left) const;
 	};
-}
\ No newline at end of file
+}
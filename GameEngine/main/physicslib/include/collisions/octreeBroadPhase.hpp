@@ -0,0 +1,39 @@
+#pragma once
+
+#include "broadPhase.hpp"
+#include "octree.hpp"
+
+namespace physicslib
+{
+	/**
+	 * Broad phase keeping one entry per body in a loose Octree across the updates
+	 * The entries of the new bodies are inserted, those of the removed bodies are removed, and only the awake
+	 * bodies are updated: a sleeping body does not move. An update costs the number of moving bodies.
+	 */
+	class OctreeBroadPhase : public BroadPhase
+	{
+	public:
+		/**
+		 * Constructor
+		 */
+		OctreeBroadPhase(const BoundingBox& bounds, const OctreeConfiguration& configuration = OctreeConfiguration());
+
+		using BroadPhase::update;
+		void update(const RigidBodyWorld& world) override;
+		void query(const BoundingBox& bounds, std::vector<RigidBodyHandle>& result) const override;
+		void getOverlappingPairs(std::vector<std::pair<RigidBodyHandle, RigidBodyHandle>>& pairs) const override;
+
+		/**
+		 * Get the octree
+		 */
+		const Octree& getOctree() const;
+
+	private:
+		Octree m_octree; // One entry per body
+		std::vector<Octree::Handle> m_bodyEntries; // The entry of the body of each slot of the world, INVALID_HANDLE if it has none
+
+		// Results of the octree, kept to reuse their memory
+		mutable std::vector<Octree::Handle> m_entries;
+		mutable std::vector<std::pair<Octree::Handle, Octree::Handle>> m_entryPairs;
+	};
+}
@@ -7,12 +7,12 @@ namespace physicslib
 	class ParticleCable : ParticleLink
 	{
 	public:
-		ParticleCable(Particle* particle1, Particle* particle2, double maxLength, double restitutionCoef);
+		ParticleCable(Particle* particle1, Particle* particle2, real maxLength, real restitutionCoef);
 		virtual ~ParticleCable();
 		void addContact(ContactRegister& contactRegister);
 
 	private:
-		double m_maxLength;
-		double m_restitutionCoef;
+		real m_maxLength;
+		real m_restitutionCoef;
 	};
 }
\ No newline at end of file
@@ -8,11 +8,11 @@ namespace physicslib
 	class ParticleContact
 	{
 	public:
-		ParticleContact(Particle* particle1, Particle* particle2, double restitution, double vs, double penetratition, Vector3 normal);
-		void resolve(double frametime);
+		ParticleContact(Particle* particle1, Particle* particle2, real restitution, real vs, real penetratition, Vector3 normal);
+		void resolve(real frametime);
 		//void calculateVariables();
 		void resolveInterpenetration();
-		void resolveVelocity(double frametime);
+		void resolveVelocity(real frametime);
 		virtual ~ParticleContact();
 
 
@@ -20,9 +20,9 @@ namespace physicslib
 	private:
 
 		Particle* m_particles[2];
-		double m_restitution;
-		double m_vs;
-		double m_penetration;
+		real m_restitution;
+		real m_vs;
+		real m_penetration;
 		Vector3 m_contactNormal;
 	};
 
@@ -10,7 +10,7 @@ namespace physicslib
 		ParticleLink(Particle* particle1, Particle* particle2);
 		virtual ~ParticleLink();
 
-		virtual double getCurrentLength();
+		virtual real getCurrentLength();
 
 	protected:
 		Particle* m_particles[2];
@@ -7,11 +7,11 @@ namespace physicslib
 	class ParticleRod : ParticleLink
 	{
 	public:
-		ParticleRod(Particle* particle1, Particle* particle2, double length);
+		ParticleRod(Particle* particle1, Particle* particle2, real length);
 		virtual ~ParticleRod();
 		void addContact(ContactRegister& contactRegister);
 
 	private:
-		double m_length;
+		real m_length;
 	};
 }
\ No newline at end of file
@@ -11,7 +11,7 @@ namespace physicslib
 		/**
 		 * Contructor
 		 */
-		PlanePrimitive(const Vector3& normal, double offset);
+		PlanePrimitive(const Vector3& normal, real offset);
 
 		/**
 		 * Default copy constructor
@@ -38,12 +38,12 @@ namespace physicslib
 		#pragma region Getters
 
 		Vector3 getNormal() const;
-		double getOffset() const;
+		real getOffset() const;
 
 		#pragma endregion
 
 	private:
 		Vector3 m_normal;
-		double m_offset;
+		real m_offset;
 	};
 }
\ No newline at end of file
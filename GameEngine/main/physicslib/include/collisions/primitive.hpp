@@ -4,6 +4,7 @@
 #include "rigidBody.hpp"
 #include "math/matrix34.hpp"
 #include "math/vector3.hpp"
+#include "span.hpp"
 
 namespace physicslib
 {
@@ -15,6 +16,12 @@ namespace physicslib
 		 */
 		Primitive(std::shared_ptr<RigidBody> rigidBody);
 
+		/**
+		 * Constructor
+		 * Create a primitive which is not attached to a RigidBody, placed by `transformMatrix`
+		 */
+		Primitive(const Matrix34& transformMatrix);
+
 		/**
 		 * Default copy constructor
 		 */
@@ -35,6 +42,17 @@ namespace physicslib
 		 */
 		virtual std::vector<Vector3> getVertices() const = 0;
 
+		/**
+		 * Get the number of vertices of the primitive
+		 */
+		virtual std::size_t getVertexCount() const;
+
+		/**
+		 * Write the vertices of the primitive in `vertices`, which must hold getVertexCount() points
+		 * The default implementation copies getVertices(), primitives override it to avoid the allocation.
+		 */
+		virtual void getVertices(Span<Vector3> vertices) const;
+
 	protected:
 		std::shared_ptr<RigidBody> m_rigidBody;
 		Matrix34 m_transformMatrix;
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "broadPhase.hpp"
+
+namespace physicslib
+{
+	/**
+	 * Sort and sweep of the bounds of the bodies along one axis, kept sorted across the updates
+	 *
+	 * The bodies are sorted by the lower endpoint of their bounds on the sweep axis; the pairs are found by sweeping
+	 * the sorted list, each body being tested against the following bodies which start before its upper endpoint.
+	 * Between two frames the bodies barely move, the list is nearly sorted and an insertion sort puts it back in
+	 * order in close to linear time: an update costs O(n), the sweep O(n + pairs). When the bodies jump around,
+	 * the insertion sort gives up after a few moves per body and the list is sorted from scratch.
+	 * The sweep axis is the one along which the centers of the bodies spread most (largest variance): for bodies
+	 * sliding on a floor, one of the horizontal axes. The list is sorted again when the axis changes, which only
+	 * happens when the variance of another axis becomes clearly larger.
+	 * The new bodies are added and the removed bodies removed at each update, the sleeping bodies are not updated.
+	 * A query scans the bodies starting before the upper endpoint of its bounds: it is linear, the structure is made
+	 * for the pairs.
+	 */
+	class SweepAndPrune : public BroadPhase
+	{
+	public:
+		using BroadPhase::update;
+		void update(const RigidBodyWorld& world) override;
+		void query(const BoundingBox& bounds, std::vector<RigidBodyHandle>& result) const override;
+		void getOverlappingPairs(std::vector<std::pair<RigidBodyHandle, RigidBodyHandle>>& pairs) const override;
+
+		/**
+		 * Get the sweep axis, 0 for x, 1 for y and 2 for z
+		 */
+		unsigned int getAxis() const;
+
+	private:
+		static constexpr real AXIS_SWITCH_RATIO = real(1.5); // The variance of a new axis must be this much larger than the current one
+		static constexpr std::size_t MAX_MOVES_BY_ENTRY = 4; // Over this average, the insertion sort gives up for a full sort
+
+		struct Entry
+		{
+			real min; // The endpoints of the bounds on the sweep axis
+			real max;
+			BoundingBox bounds;
+			RigidBodyHandle body;
+		};
+
+		unsigned int m_axis = 0;
+		std::vector<Entry> m_entries; // Sorted by lower endpoint
+		std::vector<bool> m_hasEntry; // If the body of each slot of the world has an entry
+		std::vector<BoundingBox> m_bodyBounds; // The bounds of the body of each slot of the world
+
+		/**
+		 * Compute the endpoints of the entries on the sweep axis
+		 */
+		void updateEndpoints();
+
+		/**
+		 * Sort the entries with an insertion sort, return false if it gave up before the entries were sorted
+		 */
+		bool insertionSort();
+	};
+}
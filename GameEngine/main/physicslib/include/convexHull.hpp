@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "math/vector3.hpp"
+#include "span.hpp"
+
+namespace physicslib
+{
+	/**
+	 * Compute the convex hull of a set of points
+	 *
+	 * Return 3 indices in `points` per triangle of the hull, in counterclockwise order seen from outside,
+	 * or nothing if the points are all on a plane. The hull is built incrementally from a tetrahedron of
+	 * extreme points: it is meant to be computed once per shape, not per frame.
+	 */
+	std::vector<std::uint32_t> computeConvexHull(Span<const Vector3> points);
+}
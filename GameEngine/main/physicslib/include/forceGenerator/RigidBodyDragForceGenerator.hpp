@@ -5,15 +5,42 @@
 
 namespace physicslib
 {
-	class RigidBodyDragForceGenerator : public RigidBodyForceGenerator
+	class RigidBodyDragForceGenerator final : public RigidBodyForceGenerator
 	{
 	public:
-		RigidBodyDragForceGenerator(double k1, double k2);
+		/**
+		 * Force on one body, with the arrays it reads loaded once per batch
+		 */
+		struct Kernel
+		{
+			Span<const Vector3> velocities;
+			Span<Vector3> forceAccumulators;
+			real k1;
+			real k2;
 
-		void updateForce(std::shared_ptr<RigidBody> rigidBody, const double duration) const override;
+			void operator()(std::uint32_t index) const
+			{
+				const Vector3 velocity = velocities[index];
+				real speedNorm = velocity.getNorm();
+				real squaredSpeedNorm = velocity.getSquaredNorm();
+				Vector3 normalizedSpeed = velocity.getNormalizedVector();
+
+				forceAccumulators[index] += -normalizedSpeed * (k1 * speedNorm + k2 * squaredSpeedNorm);
+			}
+		};
+
+		RigidBodyDragForceGenerator(real k1, real k2);
+
+		void updateForce(std::shared_ptr<RigidBody> rigidBody, const real duration) const override;
+		void applyBatch(Span<const std::uint32_t> indices, const RigidBodyForceState& state, const real duration) const override;
+
+		Kernel getKernel(const RigidBodyForceState& state, const real /*duration*/) const
+		{
+			return { state.world.getVelocities(), state.forceAccumulators, m_k1, m_k2 };
+		}
 
 	private:
-		const double m_k1;
-		const double m_k2;
+		const real m_k1;
+		const real m_k2;
 	};
 }
\ No newline at end of file
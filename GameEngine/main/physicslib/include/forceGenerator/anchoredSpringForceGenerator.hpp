@@ -8,12 +8,12 @@ namespace physicslib
 	class AnchoredSpringForceGenerator : public ParticleForceGenerator
 	{
 	public:
-		AnchoredSpringForceGenerator(Vector3 anchorPosition, double elasticity, double restingLength);
+		AnchoredSpringForceGenerator(Vector3 anchorPosition, real elasticity, real restingLength);
 
-		void updateForce(std::shared_ptr<Particle> particle, const double duration) const override;
+		void updateForce(std::shared_ptr<Particle> particle, const real duration) const override;
 	private:
 		const Vector3 m_anchorPosition;
-		const double m_elasticity;
-		const double m_restingLength;
+		const real m_elasticity;
+		const real m_restingLength;
 	};
 }
\ No newline at end of file
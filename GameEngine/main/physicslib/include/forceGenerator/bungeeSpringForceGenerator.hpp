@@ -8,12 +8,12 @@ namespace physicslib
 	class BungeeSpringForceGenerator : public ParticleForceGenerator
 	{
 	public:
-		BungeeSpringForceGenerator(const std::shared_ptr<const Particle> otherParticle, double elasticity, double restingLength);
+		BungeeSpringForceGenerator(const std::shared_ptr<const Particle> otherParticle, real elasticity, real restingLength);
 
-		void updateForce(std::shared_ptr<Particle> particle, const double duration) const override;
+		void updateForce(std::shared_ptr<Particle> particle, const real duration) const override;
 	private:
 		const std::shared_ptr<const Particle> m_otherParticle;
-		const double m_elasticity;
-		const double m_restingLength;
+		const real m_elasticity;
+		const real m_restingLength;
 	};
 }
\ No newline at end of file
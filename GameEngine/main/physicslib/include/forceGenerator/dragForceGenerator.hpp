@@ -8,12 +8,12 @@ namespace physicslib
 	class DragForceGenerator : public ParticleForceGenerator
 	{
 	public:
-		DragForceGenerator(double k1, double k2);
+		DragForceGenerator(real k1, real k2);
 
-		void updateForce(std::shared_ptr<Particle> particle, const double duration) const override;
+		void updateForce(std::shared_ptr<Particle> particle, const real duration) const override;
 
 	private:
-		const double m_k1;
-		const double m_k2;
+		const real m_k1;
+		const real m_k2;
 	};
 }
\ No newline at end of file
@@ -1,28 +1,163 @@
 #pragma once
 
 #include "rigidBodyForceGenerator.hpp"
+#include "RigidBodyDragForceGenerator.hpp"
+#include "rigidBodyBuoyancyForceGenerator.hpp"
+#include "rigidBodyGravityForceGenerator.hpp"
+#include "rigidBodySpringForceGenerator.hpp"
+#include "rigidBodyWorld.hpp"
+#include "workerPool.hpp"
 
 #include <vector>
 #include <memory>
+#include <variant>
 
 namespace physicslib
 {
+	/**
+	 * Registrations of force generators on the bodies of a RigidBodyWorld
+	 *
+	 * The registrations persist from one frame to the next until they are removed: a frame only pays
+	 * for the forces it evaluates. A generator is either registered on one body (a record) or on every
+	 * body of the world (a global generator, e.g. gravity), which costs a single registration.
+	 * The generators are not owned by the register, they must outlive their registrations.
+	 *
+	 * Each generator is applied in a single call per partition of the bodies, on the batch of the awake bodies of the
+	 * partition it is registered on: the records are kept grouped by generator, and the generators by type, for this purpose.
+	 *
+	 * The built-in generators are registered with their type and dispatched statically: their loops are
+	 * inlined in updateAllForces(). Any other generator, e.g. a RigidBodyForcePipeline or a user-defined
+	 * force, goes through the virtual applyBatch(). A built-in generator registered through a pointer to
+	 * RigidBodyForceGenerator is also dispatched virtually.
+	 */
 	class ForceRegister
 	{
 	public:
+		using ForceGenerator = std::variant<
+			const RigidBodyGravityForceGenerator*,
+			const RigidBodyDragForceGenerator*,
+			const RigidBodyBuoyancyForceGenerator*,
+			const RigidBodySpringForceGenerator*,
+			const RigidBodyForceGenerator*
+		>;
+
 		struct ForceRecord
 		{
-			ForceRecord(const std::shared_ptr<RigidBody> rigidBody,
-				const std::shared_ptr<const RigidBodyForceGenerator> forceGenerator);
+			ForceRecord(const RigidBodyHandle rigidBody,
+				ForceGenerator forceGenerator);
 
-			const std::shared_ptr<RigidBody> rigidBody;
-			const std::shared_ptr<const RigidBodyForceGenerator> forceGenerator;
+			RigidBodyHandle rigidBody;
+			ForceGenerator forceGenerator;
 		};
+
+		/**
+		 * Register a generator on a body
+		 * The record goes after the last record of the same generator, else of the same type of generator.
+		 */
 		void add(const ForceRecord& record);
+
+		/**
+		 * Register a generator on every body of the world
+		 */
+		void addGlobal(ForceGenerator forceGenerator);
+
+		/**
+		 * Remove the registrations of `forceGenerator` on `rigidBody`
+		 */
+		void remove(RigidBodyHandle rigidBody, const RigidBodyForceGenerator* forceGenerator);
+
+		/**
+		 * Remove all the registrations on `rigidBody`
+		 * The records of the bodies removed from the world are also dropped by the next updateAllForces().
+		 */
+		void remove(RigidBodyHandle rigidBody);
+
+		/**
+		 * Remove a global generator
+		 */
+		void removeGlobal(const RigidBodyForceGenerator* forceGenerator);
+
+		/**
+		 * Remove all the registrations
+		 */
 		void clear();
 
-		void updateAllForces(double duration);
+		/**
+		 * Get the number of registrations on single bodies
+		 */
+		std::size_t getSize() const;
+
+		/**
+		 * Apply the registered forces to the bodies of `world`, the sleeping bodies are skipped unless a record wakes them up
+		 * The forces of a body are added in the order of the global generators, then of the records, then come the
+		 * forces of the records of other bodies, e.g. the other end of a spring.
+		 */
+		void updateAllForces(RigidBodyWorld& world, real duration);
+
+		/**
+		 * Same as updateAllForces(world, duration), with the bodies split in partitions run by `workerPool`
+		 * A partition applies the global generators and the records of its bodies straight to the accumulators of the
+		 * world. Only the forces on bodies outside of a batch are kept aside by the partitions, then added in the order
+		 * of the partitions. The partitions have a fixed number of bodies: the results are the same as the serial ones,
+		 * whatever the number of threads.
+		 */
+		void updateAllForces(RigidBodyWorld& world, real duration, WorkerPool& workerPool);
 	private:
+		static const std::size_t PARTITION_SIZE = 1024; // Number of consecutive bodies of the world in a partition
+
+		/**
+		 * Record of an awake body
+		 */
+		struct AwakeRecord
+		{
+			std::uint32_t record; // Position in m_register
+			std::uint32_t index; // Index of the body in the world
+		};
+
+		/**
+		 * Buffers of a partition of the bodies
+		 */
+		struct Partition
+		{
+			std::vector<std::uint32_t> batchIndices;
+			std::vector<ForceReaction> reactions;
+		};
+
+		std::vector<ForceGenerator> m_globalGenerators;
 		std::vector<ForceRecord> m_register;
+
+		// Buffers of updateAllForces(), kept to not allocate every frame
+		std::vector<std::uint32_t> m_awakeIndices;
+		std::vector<AwakeRecord> m_awakeRecords; // Grouped by partition, in the order of m_register in a partition
+		std::vector<std::size_t> m_awakeRecordEnds; // End of the records of each partition in m_awakeRecords
+		std::vector<Partition> m_partitions;
+
+		/**
+		 * Gather the awake bodies of `world` and their records by partition, and drop the records of the removed bodies
+		 * The sleeping bodies whose records wake them up, e.g. a spring tied to an awake body, wake up first.
+		 */
+		void prepare(RigidBodyWorld& world);
+
+		/**
+		 * Apply the global generators and the records to the bodies of a partition, one batch per run of records of
+		 * the same generator
+		 */
+		void applyPartition(std::size_t partition, const RigidBodyForceState& state, real duration);
+
+		/**
+		 * Add the forces on the bodies outside of the batches to the accumulators, in the order of the partitions
+		 * A sleeping body receiving a force wakes up.
+		 */
+		void applyReactions(RigidBodyWorld& world);
+
+		/**
+		 * Get the generator of a registration, whatever its type
+		 */
+		static const RigidBodyForceGenerator* getGenerator(const ForceGenerator& forceGenerator);
+
+		/**
+		 * Apply `forceGenerator` to the bodies at `indices`
+		 */
+		static void applyBatch(const ForceGenerator& forceGenerator, Span<const std::uint32_t> indices, const RigidBodyForceState& state, real duration);
 	};
-}
\ No newline at end of file
+}
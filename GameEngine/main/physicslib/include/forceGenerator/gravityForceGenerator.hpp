@@ -10,7 +10,7 @@ namespace physicslib
 		public:
 			GravityForceGenerator(Vector3 gravity);
 
-			void updateForce(std::shared_ptr<Particle> particle, const double duration) const override;
+			void updateForce(std::shared_ptr<Particle> particle, const real duration) const override;
 
 		private:
 			const Vector3 m_gravity;
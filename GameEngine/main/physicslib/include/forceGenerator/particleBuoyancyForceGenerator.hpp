@@ -8,14 +8,14 @@ namespace physicslib
 	class ParticleBuoyancyForceGenerator : public ParticleForceGenerator
 	{
 	public :
-		ParticleBuoyancyForceGenerator(double maxDepth, double objectVolume, double liquidHeight, double liquidDensity);
+		ParticleBuoyancyForceGenerator(real maxDepth, real objectVolume, real liquidHeight, real liquidDensity);
 
-		void updateForce(std::shared_ptr<Particle> particle, const double duration) const override;
+		void updateForce(std::shared_ptr<Particle> particle, const real duration) const override;
 
 	private:
-		const double m_maxDepth;
-		const double m_objectVolume;
-		const double m_liquidHeight;
-		const double m_liquidDensity;
+		const real m_maxDepth;
+		const real m_objectVolume;
+		const real m_liquidHeight;
+		const real m_liquidDensity;
 	};
 }
\ No newline at end of file
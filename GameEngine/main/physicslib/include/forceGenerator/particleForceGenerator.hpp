@@ -12,6 +12,6 @@ namespace physicslib
 		ParticleForceGenerator() = default;
 		virtual ~ParticleForceGenerator() = default;
 
-		virtual void updateForce(std::shared_ptr<Particle> particle, const double duration) const = 0;
+		virtual void updateForce(std::shared_ptr<Particle> particle, const real duration) const = 0;
 	};
 }
\ No newline at end of file
@@ -8,14 +8,14 @@ namespace physicslib
 	class ParticleStiffSpringForceGenerator : public ParticleForceGenerator
 	{
 	public:
-		ParticleStiffSpringForceGenerator(Vector3 anchorPosition, double elasticity, double damping);
+		ParticleStiffSpringForceGenerator(Vector3 anchorPosition, real elasticity, real damping);
 		virtual ~ParticleStiffSpringForceGenerator();
 
-		void updateForce(std::shared_ptr<Particle> particle, const double duration) const override;
+		void updateForce(std::shared_ptr<Particle> particle, const real duration) const override;
 
 	private:
 		const Vector3 m_anchorPosition;
-		const double m_elasticity;
-		const double m_damping;
+		const real m_elasticity;
+		const real m_damping;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <algorithm>
+
+#include "rigidBodyForceGenerator.hpp"
+#include "math/vector3.hpp"
+
+namespace physicslib
+{
+	/**
+	 * Archimedes' thrust of a liquid whose surface is the horizontal plane y = liquidHeight
+	 * The submerged part of a body is estimated from the height of its bounds, whatever its orientation,
+	 * and its volume is the volume of its collision shape. The force is applied at the center of mass.
+	 */
+	class RigidBodyBuoyancyForceGenerator final : public RigidBodyForceGenerator
+	{
+	public:
+		/**
+		 * Force on one body, with the arrays it reads loaded once per batch
+		 */
+		struct Kernel
+		{
+			const RigidBodyBuoyancyForceGenerator& generator;
+			const CollisionShapeRegistry& collisionShapes;
+			Span<const CollisionShapeId> shapeIds;
+			Span<const Vector3> positions;
+			Span<Vector3> forceAccumulators;
+
+			void operator()(std::uint32_t index) const
+			{
+				const CollisionShape& shape = collisionShapes.get(shapeIds[index]);
+				forceAccumulators[index] += generator.getForce(positions[index].getY(), shape.getBoxSize().getY(), shape.getVolume());
+			}
+		};
+
+		RigidBodyBuoyancyForceGenerator(real liquidHeight, real liquidDensity, Vector3 gravity);
+
+		void updateForce(std::shared_ptr<RigidBody> rigidBody, const real duration) const override;
+		void applyBatch(Span<const std::uint32_t> indices, const RigidBodyForceState& state, const real duration) const override;
+
+		Kernel getKernel(const RigidBodyForceState& state, const real /*duration*/) const
+		{
+			return { *this, state.world.getCollisionShapes(), state.world.getCollisionShapeIds(), state.world.getPositions(), state.forceAccumulators };
+		}
+
+		/**
+		 * Get the thrust on a body of volume `volume` and height `height` whose center is at the height `y`
+		 */
+		Vector3 getForce(real y, real height, real volume) const
+		{
+			if (height <= 0)
+			{
+				return Vector3();
+			}
+
+			const real submergedProportion = std::min(std::max((m_liquidHeight - y) / height + real(0.5), real(0)), real(1));
+			return -m_gravity * (submergedProportion * volume * m_liquidDensity);
+		}
+
+	private:
+		const real m_liquidHeight;
+		const real m_liquidDensity;
+		const Vector3 m_gravity;
+	};
+}
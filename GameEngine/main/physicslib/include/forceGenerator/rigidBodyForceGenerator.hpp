@@ -1,17 +1,98 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
+#include <vector>
 
 #include "rigidBody.hpp"
+#include "rigidBodyWorld.hpp"
+#include "span.hpp"
 
 namespace physicslib
 {
+	/**
+	 * Force of a batch on a body outside of the batch, e.g. the other end of a spring
+	 */
+	struct ForceReaction
+	{
+		std::uint32_t index;
+		Vector3 force;
+		Vector3 torque;
+	};
+
+	/**
+	 * Bodies a batch of forces applies to: the state of the world, read only, and the accumulators receiving the forces
+	 * The accumulators are indexed like the bodies of the world.
+	 */
+	struct RigidBodyForceState
+	{
+		const RigidBodyWorld& world;
+		Span<Vector3> forceAccumulators;
+		Span<Vector3> torqueAccumulators;
+		std::vector<ForceReaction>* reactions = nullptr; // Keeps the forces on the bodies outside of the batch when it is set
+
+		/**
+		 * Apply a force to the center of mass of the body at `index`
+		 */
+		void addForce(std::size_t index, const Vector3& force) const
+		{
+			forceAccumulators[index] += force;
+		}
+
+		/**
+		 * Apply a force to a point in the world, as RigidBodyWorld::addForceAtPoint()
+		 */
+		void addForceAtPoint(std::size_t index, const Vector3& force, const Vector3& point) const
+		{
+			// Convert point to coordinates relative to the center-of-mass
+			const Vector3 localPoint = world.getTransformMatrix(index).getRotationInverse() * (point - world.getPosition(index));
+
+			forceAccumulators[index] += force;
+			torqueAccumulators[index] += localPoint.CrossProduct(force);
+		}
+
+		/**
+		 * Apply a force to a point in the world, on the body at `index` which is not a body of the batch
+		 * The batches of other bodies may run at the same time: when `reactions` is set, the force is kept there
+		 * and added to the accumulators after all the batches, waking the body up.
+		 */
+		void addReactionAtPoint(std::size_t index, const Vector3& force, const Vector3& point) const
+		{
+			if (reactions == nullptr)
+			{
+				addForceAtPoint(index, force, point);
+				return;
+			}
+
+			const Vector3 localPoint = world.getTransformMatrix(index).getRotationInverse() * (point - world.getPosition(index));
+			reactions->push_back(ForceReaction { std::uint32_t(index), force, localPoint.CrossProduct(force) });
+		}
+	};
+
 	class RigidBodyForceGenerator
 	{
 	public:
 		RigidBodyForceGenerator() = default;
 		virtual ~RigidBodyForceGenerator() = default;
 
-		virtual void updateForce(std::shared_ptr<RigidBody> rigidBody, const double duration) const = 0;
+		virtual void updateForce(std::shared_ptr<RigidBody> rigidBody, const real duration) const = 0;
+
+		/**
+		 * Apply the force to the bodies at `indices` in `state.world`
+		 * By default each body is copied into a RigidBody for updateForce(), then the forces it received are
+		 * added to the accumulators. Generators used on a world override it with a loop over the arrays of the world.
+		 * Only the accumulators of the bodies at `indices` may be written, the forces on other bodies go through
+		 * RigidBodyForceState::addReactionAtPoint().
+		 */
+		virtual void applyBatch(Span<const std::uint32_t> indices, const RigidBodyForceState& state, const real duration) const;
+
+		/**
+		 * Tell if the generator wakes up the sleeping body at `index` it is registered on, e.g. because it is tied
+		 * to an awake body. By default a sleeping body gets no force.
+		 */
+		virtual bool isWakingUp(const RigidBodyWorld& /*world*/, std::size_t /*index*/) const
+		{
+			return false;
+		}
 	};
-}
\ No newline at end of file
+}
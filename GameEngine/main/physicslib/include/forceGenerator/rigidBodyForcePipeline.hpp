@@ -0,0 +1,65 @@
+#pragma once
+
+#include <tuple>
+#include <utility>
+
+#include "rigidBodyForceGenerator.hpp"
+
+namespace physicslib
+{
+	/**
+	 * Built-in force generators composed at compile time
+	 *
+	 * The generators are held by value and applied in a single loop over the bodies: their kernels are inlined
+	 * and fused, each body is loaded once for all of them, and the pipeline costs one virtual call per batch.
+	 * Each generator must provide a Kernel through getKernel(state, duration), as the built-in generators do.
+	 * The forces of a body are added in the order of `Generators`.
+	 */
+	template <typename... Generators>
+	class RigidBodyForcePipeline final : public RigidBodyForceGenerator
+	{
+	public:
+		/**
+		 * Constructor
+		 */
+		explicit RigidBodyForcePipeline(Generators... generators)
+			: m_generators(std::move(generators)...)
+		{
+		}
+
+		void updateForce(std::shared_ptr<RigidBody> rigidBody, const real duration) const override
+		{
+			std::apply([&rigidBody, duration](const Generators&... generators)
+				{
+					(generators.updateForce(rigidBody, duration), ...);
+				}, m_generators);
+		}
+
+		void applyBatch(Span<const std::uint32_t> indices, const RigidBodyForceState& state, const real duration) const override
+		{
+			std::apply([indices, &state, duration](const Generators&... generators)
+				{
+					const std::tuple<typename Generators::Kernel...> kernels(generators.getKernel(state, duration)...);
+					for (std::uint32_t index : indices)
+					{
+						std::apply([index](const typename Generators::Kernel&... kernel)
+							{
+								(kernel(index), ...);
+							}, kernels);
+					}
+				}, m_generators);
+		}
+
+		/**
+		 * Get the generator of type `Generator`
+		 */
+		template <typename Generator>
+		const Generator& get() const
+		{
+			return std::get<Generator>(m_generators);
+		}
+
+	private:
+		const std::tuple<Generators...> m_generators;
+	};
+}
@@ -5,12 +5,36 @@
 
 namespace physicslib
 {
-	class RigidBodyGravityForceGenerator : public RigidBodyForceGenerator
+	class RigidBodyGravityForceGenerator final : public RigidBodyForceGenerator
 	{
 		public:
+			/**
+			 * Force on one body, with the arrays it reads loaded once per batch
+			 */
+			struct Kernel
+			{
+				Span<const real> inverseMasses;
+				Span<Vector3> forceAccumulators;
+				Vector3 gravity;
+
+				void operator()(std::uint32_t index) const
+				{
+					if (inverseMasses[index] != 0)
+					{
+						forceAccumulators[index] += gravity;
+					}
+				}
+			};
+
 			RigidBodyGravityForceGenerator(Vector3 gravity);
 
-			void updateForce(std::shared_ptr<RigidBody> rigidBody, const double duration) const override;
+			void updateForce(std::shared_ptr<RigidBody> rigidBody, const real duration) const override;
+			void applyBatch(Span<const std::uint32_t> indices, const RigidBodyForceState& state, const real duration) const override;
+
+			Kernel getKernel(const RigidBodyForceState& state, const real /*duration*/) const
+			{
+				return { state.world.getInverseMasses(), state.forceAccumulators, m_gravity };
+			}
 
 		private:
 			const Vector3 m_gravity;
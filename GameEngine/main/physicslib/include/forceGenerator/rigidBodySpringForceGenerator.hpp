@@ -2,22 +2,42 @@
 
 #include "rigidBodyForceGenerator.hpp"
 #include "rigidBody.hpp"
+#include "rigidBodyWorld.hpp"
 #include "math/vector3.hpp"
 
 namespace physicslib
 {
-	class RigidBodySpringForceGenerator : public RigidBodyForceGenerator
+	class RigidBodySpringForceGenerator final : public RigidBodyForceGenerator
 	{
 	public:
-		RigidBodySpringForceGenerator(Vector3 extremity1, Vector3 extremity2, const std::shared_ptr<const RigidBody> otherRigidBody, double elasticity, double restingLength);
+		RigidBodySpringForceGenerator(Vector3 extremity1, Vector3 extremity2, const std::shared_ptr<const RigidBody> otherRigidBody, real elasticity, real restingLength);
 
-		void updateForce(std::shared_ptr<RigidBody> rigidBody, const double duration) const override;
+		/**
+		 * Spring whose other end is attached to the body `otherRigidBody` of the world the generator is applied in
+		 * The spring pulls both ends: it is registered on one of its two bodies only, and wakes up a sleeping end
+		 * when the other one is awake.
+		 */
+		RigidBodySpringForceGenerator(Vector3 extremity1, Vector3 extremity2, RigidBodyHandle otherRigidBody, real elasticity, real restingLength);
+
+		void updateForce(std::shared_ptr<RigidBody> rigidBody, const real duration) const override;
+		void applyBatch(Span<const std::uint32_t> indices, const RigidBodyForceState& state, const real duration) const override;
+
+		/**
+		 * A sleeping body is pulled by the other end of the spring when it is awake
+		 */
+		bool isWakingUp(const RigidBodyWorld& world, std::size_t index) const override;
 
 	private:
 		const Vector3 m_extremity1; //Coordinates where the spring is attached, in localSpace
 		const Vector3 m_extremity2; //Coordinates where the spring is attached on otherRigidBody, in localSpace
 		const std::shared_ptr<const RigidBody> m_otherRigidBody;
-		const double m_elasticity;
-		const double m_restingLength;
+		const RigidBodyHandle m_otherRigidBodyHandle; // Invalid when the other body is m_otherRigidBody
+		const real m_elasticity;
+		const real m_restingLength;
+
+		/**
+		 * Get the force of the spring from its world space extremities
+		 */
+		Vector3 getForce(const Vector3& extremity1, const Vector3& extremity2) const;
 	};
-}
\ No newline at end of file
+}
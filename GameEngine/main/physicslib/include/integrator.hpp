@@ -0,0 +1,140 @@
+#pragma once
+
+#include <cmath>
+#include "math/expression.hpp"
+#include "math/quaternion.hpp"
+#include "math/vector3.hpp"
+
+namespace physicslib
+{
+	/**
+	 * Integration scheme of the bodies, chosen per body container
+	 */
+	enum class Integrator
+	{
+		SEMI_IMPLICIT_EULER, // First order, symplectic: the velocity is updated first and moves the position
+		VELOCITY_VERLET, // Second order, symplectic: the velocity uses the mean of the accelerations of the step ends
+		RUNGE_KUTTA_4 // Fourth order on the orientation, exact under constant acceleration on the position
+	};
+
+	/**
+	 * Integrator policies
+	 *
+	 * Each policy advances the linear state (position, velocity) and the angular state (orientation, angular velocity)
+	 * of a body over a step. The forces are sampled once per step by the force generators, so the acceleration is
+	 * constant over the step; `previousAcceleration` is the acceleration of the previous step.
+	 * integrateAngular() returns true if the orientation changed.
+	 * The policies can be used directly as template parameters, or selected at runtime through visit().
+	 */
+	namespace integrator
+	{
+		struct SemiImplicitEuler
+		{
+			static void integrateLinear(Vector3& position, Vector3& velocity, const Vector3& /*previousAcceleration*/, const Vector3& acceleration, real frameTime)
+			{
+				velocity = velocity + expression::lazy(acceleration) * frameTime;
+				position = position + expression::lazy(velocity) * frameTime;
+			}
+
+			static bool integrateAngular(Quaternion& orientation, Vector3& angularVelocity, const Vector3& /*previousAngularAcceleration*/, const Vector3& angularAcceleration,
+				real angularDamping, real frameTime)
+			{
+				angularVelocity = expression::lazy(angularVelocity) * std::pow(angularDamping, frameTime) + expression::lazy(angularAcceleration) * frameTime;
+				if (angularVelocity.getSquaredNorm() == 0)
+				{
+					return false;
+				}
+
+				orientation.updateOrientation(angularVelocity, frameTime);
+				return true;
+			}
+		};
+
+		/**
+		 * The acceleration at the end of a step is only known at the next step: the velocity is first predicted
+		 * with the acceleration of the step start, then corrected at the next step with the half difference
+		 * of the two accelerations. The positions are those of the velocity Verlet scheme for a constant step.
+		 * The initial acceleration of a body is the previous acceleration of its first step.
+		 */
+		struct VelocityVerlet
+		{
+			static void integrateLinear(Vector3& position, Vector3& velocity, const Vector3& previousAcceleration, const Vector3& acceleration, real frameTime)
+			{
+				velocity = velocity + expression::lazy(acceleration - previousAcceleration) * (frameTime / 2);
+				position = position + expression::lazy(velocity) * frameTime + expression::lazy(acceleration) * (frameTime * frameTime / 2);
+				velocity = velocity + expression::lazy(acceleration) * frameTime;
+			}
+
+			static bool integrateAngular(Quaternion& orientation, Vector3& angularVelocity, const Vector3& previousAngularAcceleration, const Vector3& angularAcceleration,
+				real angularDamping, real frameTime)
+			{
+				angularVelocity = angularVelocity + expression::lazy(angularAcceleration - previousAngularAcceleration) * (frameTime / 2);
+
+				// The orientation turns with the angular velocity of the middle of the step
+				const Vector3 middleAngularVelocity = expression::lazy(angularVelocity) * std::pow(angularDamping, frameTime / 2) + expression::lazy(angularAcceleration) * (frameTime / 2);
+				angularVelocity = expression::lazy(angularVelocity) * std::pow(angularDamping, frameTime) + expression::lazy(angularAcceleration) * frameTime;
+				if (middleAngularVelocity.getSquaredNorm() == 0)
+				{
+					return false;
+				}
+
+				orientation.updateOrientation(middleAngularVelocity, frameTime);
+				return true;
+			}
+		};
+
+		/**
+		 * Under a constant acceleration the linear state has an exact solution, which RK4 reproduces.
+		 * The orientation follows q' = w(t) q / 2, with w(t) the damped and accelerated angular velocity.
+		 */
+		struct RungeKutta4
+		{
+			static void integrateLinear(Vector3& position, Vector3& velocity, const Vector3& /*previousAcceleration*/, const Vector3& acceleration, real frameTime)
+			{
+				position = position + expression::lazy(velocity) * frameTime + expression::lazy(acceleration) * (frameTime * frameTime / 2);
+				velocity = velocity + expression::lazy(acceleration) * frameTime;
+			}
+
+			static bool integrateAngular(Quaternion& orientation, Vector3& angularVelocity, const Vector3& /*previousAngularAcceleration*/, const Vector3& angularAcceleration,
+				real angularDamping, real frameTime)
+			{
+				const Vector3 startAngularVelocity = angularVelocity;
+				const Vector3 middleAngularVelocity = expression::lazy(startAngularVelocity) * std::pow(angularDamping, frameTime / 2) + expression::lazy(angularAcceleration) * (frameTime / 2);
+				angularVelocity = expression::lazy(startAngularVelocity) * std::pow(angularDamping, frameTime) + expression::lazy(angularAcceleration) * frameTime;
+				if (startAngularVelocity.getSquaredNorm() == 0 && middleAngularVelocity.getSquaredNorm() == 0 && angularVelocity.getSquaredNorm() == 0)
+				{
+					return false;
+				}
+
+				const Quaternion startOmega(0, startAngularVelocity);
+				const Quaternion middleOmega(0, middleAngularVelocity);
+				const Quaternion endOmega(0, angularVelocity);
+				const Quaternion k1 = startOmega * orientation * real(0.5);
+				const Quaternion k2 = middleOmega * (orientation + k1 * (frameTime / 2)) * real(0.5);
+				const Quaternion k3 = middleOmega * (orientation + k2 * (frameTime / 2)) * real(0.5);
+				const Quaternion k4 = endOmega * (orientation + k3 * frameTime) * real(0.5);
+				orientation += (k1 + k2 * 2 + k3 * 2 + k4) * (frameTime / 6);
+				orientation.normalize();
+				return true;
+			}
+		};
+
+		/**
+		 * Call `function` with the policy of `type`
+		 * Dispatching once around a loop over the bodies lets each loop be compiled for its policy.
+		 */
+		template <typename Function>
+		decltype(auto) visit(Integrator type, Function&& function)
+		{
+			switch (type)
+			{
+			case Integrator::VELOCITY_VERLET:
+				return function(VelocityVerlet());
+			case Integrator::RUNGE_KUTTA_4:
+				return function(RungeKutta4());
+			default:
+				return function(SemiImplicitEuler());
+			}
+		}
+	}
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstdint>
+#include "math/matrix3.hpp"
+#include "math/vector3.hpp"
+#include "span.hpp"
+
+namespace physicslib
+{
+	/**
+	 * Mass properties of a solid of unit density
+	 */
+	struct MassProperties
+	{
+		real volume = 0; // Also the mass, for a unit density
+		Vector3 centerOfMass; // In the coordinates of the vertices
+		Matrix3 inertiaTensor; // Around the center of mass, for the mass `volume`
+	};
+
+	/**
+	 * Compute the exact mass properties of the solid bounded by a closed triangle mesh
+	 *
+	 * `indices` holds 3 vertex indices per triangle, in counterclockwise order seen from outside.
+	 * The volume integrals are turned into sums over the triangles (divergence theorem), so the
+	 * result is exact for any closed polyhedron, convex or not, in a single pass over the triangles.
+	 */
+	MassProperties computeMassProperties(Span<const Vector3> vertices, Span<const std::uint32_t> indices);
+}
@@ -0,0 +1,303 @@
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+#include "math/quaternion.hpp"
+#include "math/real.hpp"
+#include "math/vector3.hpp"
+
+/*
+ * Opt-in expression templates for Vector3 and Quaternion arithmetic.
+ *
+ * Wrapping an operand with expression::lazy() turns the operations applied to it into an expression
+ * tree instead of a chain of temporaries. Nothing is computed until the tree is converted into a
+ * Vector3 (or a Quaternion): every component is then evaluated in a single fused pass, fully inlined.
+ * The innermost vector has to be wrapped, operations between plain vectors stay eager:
+ *
+ *     Vector3 move = position + expression::lazy(normal) * penetration * (m1 / (m1 + m2));
+ *
+ * Trees hold their operands by value, so they never dangle, but they are meant to be
+ * converted in the statement that builds them, not stored with `auto`.
+ * Plain Vector3 and Quaternion operators are untouched and stay eager.
+ */
+namespace physicslib
+{
+	namespace expression
+	{
+		template <typename Derived, std::size_t Size>
+		struct Expression;
+
+		/**
+		 * Base of the expressions of 3 components: they convert to Vector3
+		 */
+		template <typename Derived>
+		struct Expression<Derived, 3>
+		{
+			static constexpr std::size_t SIZE = 3;
+
+			Vector3 evaluate() const
+			{
+				const Derived& expression = static_cast<const Derived&>(*this);
+				return Vector3(expression.get(0), expression.get(1), expression.get(2));
+			}
+
+			operator Vector3() const
+			{
+				return evaluate();
+			}
+		};
+
+		/**
+		 * Base of the expressions of 4 components: they convert to Quaternion (r, i, j, k)
+		 */
+		template <typename Derived>
+		struct Expression<Derived, 4>
+		{
+			static constexpr std::size_t SIZE = 4;
+
+			Quaternion evaluate() const
+			{
+				const Derived& expression = static_cast<const Derived&>(*this);
+				return Quaternion(expression.get(0), expression.get(1), expression.get(2), expression.get(3));
+			}
+
+			operator Quaternion() const
+			{
+				return evaluate();
+			}
+		};
+
+		template <typename T>
+		struct IsExpression
+		{
+			template <typename Derived, std::size_t Size>
+			static std::true_type test(const Expression<Derived, Size>*);
+			static std::false_type test(...);
+
+			static constexpr bool value = decltype(test(std::declval<const T*>()))::value;
+		};
+
+		// -------
+		// Leaves
+		// -------
+		class VectorLeaf : public Expression<VectorLeaf, 3>
+		{
+		public:
+			explicit VectorLeaf(const Vector3& vector) : m_vector(vector) {}
+
+			real get(std::size_t i) const
+			{
+				return (i == 0) ? m_vector.getX() : (i == 1) ? m_vector.getY() : m_vector.getZ();
+			}
+
+		private:
+			Vector3 m_vector;
+		};
+
+		class QuaternionLeaf : public Expression<QuaternionLeaf, 4>
+		{
+		public:
+			explicit QuaternionLeaf(const Quaternion& quaternion) : m_quaternion(quaternion) {}
+
+			real get(std::size_t i) const
+			{
+				return (i == 0) ? m_quaternion.getR() : (i == 1) ? m_quaternion.getI() : (i == 2) ? m_quaternion.getJ() : m_quaternion.getK();
+			}
+
+		private:
+			Quaternion m_quaternion;
+		};
+
+		/**
+		 * Start an expression tree from a vector
+		 */
+		inline VectorLeaf lazy(const Vector3& vector)
+		{
+			return VectorLeaf(vector);
+		}
+
+		/**
+		 * Start an expression tree from a quaternion
+		 */
+		inline QuaternionLeaf lazy(const Quaternion& quaternion)
+		{
+			return QuaternionLeaf(quaternion);
+		}
+
+		/**
+		 * Expressions are used as they are, vectors and quaternions become leaves
+		 */
+		template <typename T>
+		inline decltype(auto) asExpression(const T& operand)
+		{
+			if constexpr (IsExpression<T>::value)
+			{
+				return operand;
+			}
+			else
+			{
+				return lazy(operand);
+			}
+		}
+
+		/**
+		 * Type of asExpression(T), undefined for the other types (scalars...) to disable the operators
+		 */
+		template <typename T, typename = void>
+		struct ExpressionType
+		{
+		};
+
+		template <typename T>
+		struct ExpressionType<T, std::enable_if_t<IsExpression<T>::value>>
+		{
+			using type = T;
+		};
+
+		template <>
+		struct ExpressionType<Vector3>
+		{
+			using type = VectorLeaf;
+		};
+
+		template <>
+		struct ExpressionType<Quaternion>
+		{
+			using type = QuaternionLeaf;
+		};
+
+		template <typename T>
+		using ExpressionOf = typename ExpressionType<T>::type;
+
+		// ------
+		// Nodes
+		// ------
+		template <typename Left, typename Right>
+		class Sum : public Expression<Sum<Left, Right>, Left::SIZE>
+		{
+		public:
+			Sum(const Left& left, const Right& right) : m_left(left), m_right(right) {}
+
+			real get(std::size_t i) const { return m_left.get(i) + m_right.get(i); }
+
+		private:
+			Left m_left;
+			Right m_right;
+		};
+
+		template <typename Left, typename Right>
+		class Difference : public Expression<Difference<Left, Right>, Left::SIZE>
+		{
+		public:
+			Difference(const Left& left, const Right& right) : m_left(left), m_right(right) {}
+
+			real get(std::size_t i) const { return m_left.get(i) - m_right.get(i); }
+
+		private:
+			Left m_left;
+			Right m_right;
+		};
+
+		template <typename Operand>
+		class Negation : public Expression<Negation<Operand>, Operand::SIZE>
+		{
+		public:
+			explicit Negation(const Operand& operand) : m_operand(operand) {}
+
+			real get(std::size_t i) const { return -m_operand.get(i); }
+
+		private:
+			Operand m_operand;
+		};
+
+		template <typename Operand>
+		class Product : public Expression<Product<Operand>, Operand::SIZE>
+		{
+		public:
+			Product(const Operand& operand, real scalar) : m_operand(operand), m_scalar(scalar) {}
+
+			real get(std::size_t i) const { return m_operand.get(i) * m_scalar; }
+
+		private:
+			Operand m_operand;
+			real m_scalar;
+		};
+
+		template <typename Operand>
+		class Quotient : public Expression<Quotient<Operand>, Operand::SIZE>
+		{
+		public:
+			Quotient(const Operand& operand, real scalar) : m_operand(operand), m_scalar(scalar) {}
+
+			real get(std::size_t i) const { return m_operand.get(i) / m_scalar; }
+
+		private:
+			Operand m_operand;
+			real m_scalar;
+		};
+
+		// ----------
+		// Operators
+		// ----------
+
+		// Enabled when at least one operand is an expression and both have the same size
+		template <typename Left, typename Right>
+		using EnableIfExpressions = std::enable_if_t<
+			(IsExpression<Left>::value || IsExpression<Right>::value)
+			&& ExpressionOf<Left>::SIZE == ExpressionOf<Right>::SIZE>;
+
+		template <typename Left, typename Right, typename = EnableIfExpressions<Left, Right>>
+		inline Sum<ExpressionOf<Left>, ExpressionOf<Right>> operator+(const Left& left, const Right& right)
+		{
+			return { asExpression(left), asExpression(right) };
+		}
+
+		template <typename Left, typename Right, typename = EnableIfExpressions<Left, Right>>
+		inline Difference<ExpressionOf<Left>, ExpressionOf<Right>> operator-(const Left& left, const Right& right)
+		{
+			return { asExpression(left), asExpression(right) };
+		}
+
+		template <typename Operand, typename = std::enable_if_t<IsExpression<Operand>::value>>
+		inline Negation<Operand> operator-(const Operand& operand)
+		{
+			return Negation<Operand>(operand);
+		}
+
+		template <typename Operand, typename = std::enable_if_t<IsExpression<Operand>::value>>
+		inline Product<Operand> operator*(const Operand& operand, real scalar)
+		{
+			return { operand, scalar };
+		}
+
+		template <typename Operand, typename = std::enable_if_t<IsExpression<Operand>::value>>
+		inline Product<Operand> operator*(real scalar, const Operand& operand)
+		{
+			return { operand, scalar };
+		}
+
+		template <typename Operand, typename = std::enable_if_t<IsExpression<Operand>::value>>
+		inline Quotient<Operand> operator/(const Operand& operand, real scalar)
+		{
+			return { operand, scalar };
+		}
+
+		/**
+		 * Product of two operands with the semantics of the eager types:
+		 * dot product for vectors, Hamilton product for quaternions.
+		 * Both need every component of their operands, so the operands are evaluated first.
+		 */
+		template <typename Left, typename Right, typename = EnableIfExpressions<Left, Right>>
+		inline auto operator*(const Left& left, const Right& right)
+		{
+			if constexpr (ExpressionOf<Left>::SIZE == 3)
+			{
+				return asExpression(left).evaluate() * asExpression(right).evaluate();
+			}
+			else
+			{
+				return lazy(asExpression(left).evaluate() * asExpression(right).evaluate());
+			}
+		}
+	}
+}
@@ -0,0 +1,556 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include "math/quaternion.hpp"
+#include "math/simd.hpp"
+#include "math/vector3.hpp"
+
+namespace physicslib
+{
+	/**
+	 * Matrix of `Rows` x `Columns` scalars stored row by row
+	 *
+	 * A 3x4 matrix is an affine transform: the 3x3 block is the linear part,
+	 * the last column is the translation and the implicit last line is (0, 0, 0, 1).
+	 *
+	 * Construction, element access, transposition, determinant and inverse are constexpr
+	 * and every product is unrolled at compile time. Only the composition of 3x4 matrices of `real`
+	 * goes through the SIMD backend, where a row fills a register; the rest is faster with scalars.
+	 */
+	template <std::size_t Rows, std::size_t Columns, typename Scalar = real>
+	class Matrix
+	{
+	public:
+		using ScalarType = Scalar;
+
+		static constexpr std::size_t ROW_COUNT = Rows;
+		static constexpr std::size_t COLUMN_COUNT = Columns;
+
+		/**
+		 * Default constructor
+		 * Create the identity matrix (ones on the diagonal, zeros elsewhere)
+		 */
+		constexpr Matrix()
+			: m_data()
+		{
+			for (std::size_t i = 0; i < Rows && i < Columns; ++i)
+			{
+				(*this)(i, i) = Scalar(1);
+			}
+		}
+
+		/**
+		 * Create a matrix filled with the number `fillNumber`
+		 */
+		explicit constexpr Matrix(Scalar fillNumber)
+			: m_data()
+		{
+			for (Scalar& n : m_data)
+			{
+				n = fillNumber;
+			}
+		}
+
+		/**
+		 * Create a matrix with an initializer list, row by row
+		 * `Matrix3 mat { 0, 1, 2, 3, 4, 5, 6, 7, 8 }`
+		 * Missing elements are set to 0, extra elements are ignored.
+		 */
+		constexpr Matrix(const std::initializer_list<Scalar>& initializerList)
+			: m_data()
+		{
+			std::size_t i = 0;
+			for (auto n = initializerList.begin(); n != initializerList.end() && i < SIZE; ++n, ++i)
+			{
+				m_data[i] = *n;
+			}
+		}
+
+		/**
+		 * Create a matrix from its elements, row by row
+		 */
+		constexpr Matrix(const std::array<Scalar, Rows * Columns>& data)
+			: m_data(data)
+		{
+		}
+
+		/**
+		 * Create a rotation matrix from a quaternion
+		 * The translation of a 3x4 matrix is null.
+		 */
+		template <std::size_t R = Rows, std::size_t C = Columns, typename = std::enable_if_t<R == 3 && (C == 3 || C == 4)>>
+		Matrix(const Quaternion& quaternion)
+			: Matrix()
+		{
+			const Scalar r = Scalar(quaternion.getR());
+			const Scalar i = Scalar(quaternion.getI());
+			const Scalar j = Scalar(quaternion.getJ());
+			const Scalar k = Scalar(quaternion.getK());
+
+			(*this)(0, 0) = 1 - (2 * j * j + 2 * k * k);
+			(*this)(0, 1) = 2 * i * j + 2 * k * r;
+			(*this)(0, 2) = 2 * i * k - 2 * j * r;
+			(*this)(1, 0) = 2 * i * j - 2 * k * r;
+			(*this)(1, 1) = 1 - (2 * i * i + 2 * k * k);
+			(*this)(1, 2) = 2 * j * k + 2 * i * r;
+			(*this)(2, 0) = 2 * i * k + 2 * j * r;
+			(*this)(2, 1) = 2 * j * k - 2 * i * r;
+			(*this)(2, 2) = 1 - (2 * i * i + 2 * j * j);
+		}
+
+		/**
+		 * Create an affine matrix 3x4 from a matrix 3x3 and a translation vector
+		 */
+		template <std::size_t R = Rows, std::size_t C = Columns, typename = std::enable_if_t<R == 3 && C == 4>>
+		Matrix(const Matrix<3, 3, Scalar>& matrix3, const Vector3& vector = Vector3())
+			: Matrix(std::array<Scalar, 12> {
+				matrix3(0, 0), matrix3(0, 1), matrix3(0, 2), Scalar(vector.getX()),
+				matrix3(1, 0), matrix3(1, 1), matrix3(1, 2), Scalar(vector.getY()),
+				matrix3(2, 0), matrix3(2, 1), matrix3(2, 2), Scalar(vector.getZ())
+			})
+		{
+		}
+
+		/**
+		 * Default copy constructor
+		 */
+		constexpr Matrix(const Matrix& anotherMatrix) = default;
+
+		/**
+		 * Default assignment operator
+		 */
+		Matrix& operator=(const Matrix& anotherMatrix) = default;
+
+		/**
+		 * Get the determinant of the matrix
+		 * For an affine matrix 3x4, it is the determinant of the linear part
+		 */
+		constexpr Scalar getDeterminant() const
+		{
+			static_assert(Rows == 3 && (Columns == 3 || Columns == 4), "The determinant is only available for 3x3 and 3x4 matrices");
+
+			return (*this)(0, 0) * (*this)(1, 1) * (*this)(2, 2)
+				 + (*this)(1, 0) * (*this)(2, 1) * (*this)(0, 2)
+				 + (*this)(2, 0) * (*this)(0, 1) * (*this)(1, 2)
+				 - (*this)(0, 0) * (*this)(2, 1) * (*this)(1, 2)
+				 - (*this)(2, 0) * (*this)(1, 1) * (*this)(0, 2)
+				 - (*this)(1, 0) * (*this)(0, 1) * (*this)(2, 2);
+		}
+
+		/**
+		 * Reverses the matrix
+		 * A singular matrix is left unchanged
+		 */
+		constexpr void reverse()
+		{
+			*this = getReverseMatrix();
+		}
+
+		/**
+		 * Return reversed matrix in a new matrix object
+		 * 3x3: cofactor formula. 3x4: affine inverse (reversed linear part, translation -L^-1 t)
+		 */
+		constexpr Matrix getReverseMatrix() const
+		{
+			static_assert(Rows == 3 && (Columns == 3 || Columns == 4), "The inverse is only available for 3x3 and 3x4 matrices");
+
+			const Scalar determinant = getDeterminant();
+			if (determinant == Scalar(0))
+			{
+				return *this;
+			}
+
+			Matrix newMatrix(*this);
+			newMatrix(0, 0) = ((*this)(1, 1) * (*this)(2, 2) - (*this)(1, 2) * (*this)(2, 1)) / determinant;
+			newMatrix(0, 1) = ((*this)(0, 2) * (*this)(2, 1) - (*this)(0, 1) * (*this)(2, 2)) / determinant;
+			newMatrix(0, 2) = ((*this)(0, 1) * (*this)(1, 2) - (*this)(0, 2) * (*this)(1, 1)) / determinant;
+
+			newMatrix(1, 0) = ((*this)(1, 2) * (*this)(2, 0) - (*this)(1, 0) * (*this)(2, 2)) / determinant;
+			newMatrix(1, 1) = ((*this)(0, 0) * (*this)(2, 2) - (*this)(0, 2) * (*this)(2, 0)) / determinant;
+			newMatrix(1, 2) = ((*this)(0, 2) * (*this)(1, 0) - (*this)(0, 0) * (*this)(1, 2)) / determinant;
+
+			newMatrix(2, 0) = ((*this)(1, 0) * (*this)(2, 1) - (*this)(1, 1) * (*this)(2, 0)) / determinant;
+			newMatrix(2, 1) = ((*this)(0, 1) * (*this)(2, 0) - (*this)(0, 0) * (*this)(2, 1)) / determinant;
+			newMatrix(2, 2) = ((*this)(0, 0) * (*this)(1, 1) - (*this)(0, 1) * (*this)(1, 0)) / determinant;
+
+			if constexpr (Columns == 4)
+			{
+				for (std::size_t row = 0; row < 3; ++row)
+				{
+					newMatrix(row, 3) = -(newMatrix(row, 0) * (*this)(0, 3) + newMatrix(row, 1) * (*this)(1, 3) + newMatrix(row, 2) * (*this)(2, 3));
+				}
+			}
+
+			return newMatrix;
+		}
+
+		/**
+		 * Return the inverse of a rotation (3x3) or of a rigid transform (3x4) in a new matrix object
+		 * The 3x3 block must be orthonormal: its inverse is its transpose, and the translation becomes -R^T t.
+		 * Much cheaper than getReverseMatrix(), which works for any invertible linear or affine matrix.
+		 */
+		constexpr Matrix getRotationInverse() const
+		{
+			static_assert(Rows == 3 && (Columns == 3 || Columns == 4), "The rotation inverse is only available for 3x3 and 3x4 matrices");
+
+			Matrix newMatrix(*this);
+			for (std::size_t row = 0; row < 3; ++row)
+			{
+				for (std::size_t column = 0; column < 3; ++column)
+				{
+					newMatrix(row, column) = (*this)(column, row);
+				}
+			}
+
+			if constexpr (Columns == 4)
+			{
+				for (std::size_t row = 0; row < 3; ++row)
+				{
+					newMatrix(row, 3) = -(newMatrix(row, 0) * (*this)(0, 3) + newMatrix(row, 1) * (*this)(1, 3) + newMatrix(row, 2) * (*this)(2, 3));
+				}
+			}
+
+			return newMatrix;
+		}
+
+		/**
+		 * Transposes the matrix
+		 */
+		constexpr void transpose()
+		{
+			*this = getTransposedMatrix();
+		}
+
+		/**
+		 * Return transposed matrix in a new matrix object
+		 */
+		constexpr Matrix getTransposedMatrix() const
+		{
+			static_assert(Rows == Columns, "Only square matrices can be transposed in place");
+
+			Matrix newMatrix(*this);
+			for (std::size_t row = 0; row < Rows; ++row)
+			{
+				for (std::size_t column = 0; column < Columns; ++column)
+				{
+					newMatrix(row, column) = (*this)(column, row);
+				}
+			}
+
+			return newMatrix;
+		}
+
+		// Matrix mathematical operations
+		Matrix operator-() const
+		{
+			Matrix newMatrix(*this);
+			newMatrix *= Scalar(-1);
+
+			return newMatrix;
+		}
+
+		Matrix& operator+=(const Matrix& anotherMatrix)
+		{
+			// Term-term addition
+			transformTerms(anotherMatrix, std::plus<Scalar>());
+
+			return *this;
+		}
+
+		Matrix operator+(const Matrix& anotherMatrix) const
+		{
+			Matrix newMatrix(*this);
+			newMatrix += anotherMatrix;
+
+			return newMatrix;
+		}
+
+		Matrix& operator-=(const Matrix& anotherMatrix)
+		{
+			// Term-term substraction
+			transformTerms(anotherMatrix, std::minus<Scalar>());
+
+			return *this;
+		}
+
+		Matrix operator-(const Matrix& anotherMatrix) const
+		{
+			Matrix newMatrix(*this);
+			newMatrix -= anotherMatrix;
+
+			return newMatrix;
+		}
+
+		/**
+		 * Matrix product (3x3) or composition of affine transforms (3x4)
+		 */
+		Matrix& operator*=(const Matrix& anotherMatrix)
+		{
+			*this = (*this) * anotherMatrix;
+
+			return *this;
+		}
+
+		// Matrix/scalar operations
+		Matrix& operator+=(const Scalar scalar)
+		{
+			// m_data[i] += scalar
+			transformTerms(Matrix(scalar), std::plus<Scalar>());
+
+			return *this;
+		}
+
+		Matrix& operator-=(const Scalar scalar)
+		{
+			// m_data[i] -= scalar
+			transformTerms(Matrix(scalar), std::minus<Scalar>());
+
+			return *this;
+		}
+
+		Matrix& operator*=(const Scalar scalar)
+		{
+			// m_data[i] *= scalar
+			transformTerms(Matrix(scalar), std::multiplies<Scalar>());
+
+			return *this;
+		}
+
+		Matrix& operator/=(const Scalar scalar)
+		{
+			// m_data[i] /= scalar
+			transformTerms(Matrix(scalar), std::divides<Scalar>());
+
+			return *this;
+		}
+
+		/**
+		 * Setter
+		 * `mat(i, j) = 3;`
+		 */
+		constexpr Scalar& operator()(const std::size_t row, const std::size_t column)
+		{
+			return m_data[Columns * row + column];
+		}
+
+		/**
+		 * Getter
+		 * `real n = mat(i, j);`
+		 */
+		constexpr const Scalar& operator()(const std::size_t row, const std::size_t column) const
+		{
+			return m_data[Columns * row + column];
+		}
+
+		/**
+		 * Get the size of a square matrix
+		 */
+		constexpr std::size_t getSize() const
+		{
+			static_assert(Rows == Columns, "Only square matrices have a size, use ROW_COUNT and COLUMN_COUNT");
+
+			return Rows;
+		}
+
+		/**
+		 * Return the string representation of the matrix
+		 */
+		std::string toString() const
+		{
+			std::string str = "{ ";
+			for (Scalar n : m_data)
+			{
+				str += std::to_string(n);
+				str += " ";
+			}
+			str += "}";
+
+			return str;
+		}
+
+	private:
+		static constexpr std::size_t SIZE = Rows * Columns;
+
+		std::array<Scalar, SIZE> m_data;
+
+		/**
+		 * m_data[i] = operation(m_data[i], anotherMatrix.m_data[i])
+		 */
+		template <typename Operation>
+		void transformTerms(const Matrix& anotherMatrix, Operation operation)
+		{
+			for (std::size_t i = 0; i < SIZE; ++i)
+			{
+				m_data[i] = operation(m_data[i], anotherMatrix.m_data[i]);
+			}
+		}
+	};
+
+	namespace detail
+	{
+		/**
+		 * ((a(Row, 0) * b(0, Column) + a(Row, 1) * b(1, Column)) + ...)
+		 */
+		template <std::size_t Row, std::size_t Column, std::size_t Rows, std::size_t Inner, std::size_t Columns, typename Scalar, std::size_t... K>
+		constexpr Scalar productTerm(const Matrix<Rows, Inner, Scalar>& a, const Matrix<Inner, Columns, Scalar>& b, std::index_sequence<K...>)
+		{
+			return (... + (a(Row, K) * b(K, Column)));
+		}
+
+		template <std::size_t Rows, std::size_t Inner, std::size_t Columns, typename Scalar, std::size_t... Indices>
+		constexpr Matrix<Rows, Columns, Scalar> product(const Matrix<Rows, Inner, Scalar>& a, const Matrix<Inner, Columns, Scalar>& b, std::index_sequence<Indices...>)
+		{
+			return Matrix<Rows, Columns, Scalar>(std::array<Scalar, Rows * Columns> {
+				productTerm<Indices / Columns, Indices % Columns>(a, b, std::make_index_sequence<Inner>())...
+			});
+		}
+
+		/**
+		 * Row `row` of `matrix` times `rows`, the 3 first rows of another matrix stored in registers
+		 * `extra` is added last, after the 3 products
+		 */
+		template <std::size_t Columns>
+		inline simd::Register combineRows(const Matrix<3, Columns, real>& matrix, std::size_t row, const simd::Register (&rows)[3], const simd::Register& extra)
+		{
+			simd::Register newRow = simd::mul(simd::splat(matrix(row, 0)), rows[0]);
+			newRow = simd::add(newRow, simd::mul(simd::splat(matrix(row, 1)), rows[1]));
+			newRow = simd::add(newRow, simd::mul(simd::splat(matrix(row, 2)), rows[2]));
+
+			return simd::add(newRow, extra);
+		}
+	}
+
+	/**
+	 * Matrix product
+	 * Unrolled at compile time
+	 */
+	template <std::size_t Rows, std::size_t Inner, std::size_t Columns, typename Scalar>
+	inline Matrix<Rows, Columns, Scalar> operator*(const Matrix<Rows, Inner, Scalar>& a, const Matrix<Inner, Columns, Scalar>& b)
+	{
+		return detail::product(a, b, std::make_index_sequence<Rows * Columns>());
+	}
+
+	/**
+	 * Composition of two affine transforms 3x4
+	 * The implicit last line (0, 0, 0, 1) of b brings the translation of a
+	 * The rows of 4 `real` fill a whole register, so the SIMD backend handles them when it is vectorized
+	 */
+	template <typename Scalar>
+	inline Matrix<3, 4, Scalar> operator*(const Matrix<3, 4, Scalar>& a, const Matrix<3, 4, Scalar>& b)
+	{
+		if constexpr (std::is_same<Scalar, real>::value && simd::IS_VECTORIZED)
+		{
+			const simd::Register rows[3] = { simd::load(&b(0, 0)), simd::load(&b(1, 0)), simd::load(&b(2, 0)) };
+
+			Matrix<3, 4, real> newMatrix;
+			simd::store(&newMatrix(0, 0), detail::combineRows(a, 0, rows, simd::set(real(0), real(0), real(0), a(0, 3))));
+			simd::store(&newMatrix(1, 0), detail::combineRows(a, 1, rows, simd::set(real(0), real(0), real(0), a(1, 3))));
+			simd::store(&newMatrix(2, 0), detail::combineRows(a, 2, rows, simd::set(real(0), real(0), real(0), a(2, 3))));
+
+			return newMatrix;
+		}
+		else
+		{
+			Matrix<3, 4, Scalar> newMatrix;
+			for (std::size_t row = 0; row < 3; ++row)
+			{
+				for (std::size_t column = 0; column < 4; ++column)
+				{
+					newMatrix(row, column) = a(row, 0) * b(0, column) + a(row, 1) * b(1, column) + a(row, 2) * b(2, column)
+						+ (column == 3 ? a(row, 3) : Scalar(0));
+				}
+			}
+
+			return newMatrix;
+		}
+	}
+
+	/**
+	 * Matrix/vector product
+	 * 3x3: linear transform of the vector. 3x4: transform of the point (translation applied)
+	 */
+	template <std::size_t Columns, typename Scalar>
+	inline Vector3 operator*(const Matrix<3, Columns, Scalar>& matrix, const Vector3& vector)
+	{
+		static_assert(Columns == 3 || Columns == 4, "Only 3x3 and 3x4 matrices transform a Vector3");
+
+		Scalar coordinates[3];
+		for (std::size_t row = 0; row < 3; ++row)
+		{
+			coordinates[row] = matrix(row, 0) * vector.getX() + matrix(row, 1) * vector.getY() + matrix(row, 2) * vector.getZ();
+			if constexpr (Columns == 4)
+			{
+				coordinates[row] += matrix(row, 3);
+			}
+		}
+
+		return Vector3(coordinates[0], coordinates[1], coordinates[2]);
+	}
+
+	// Matrix/scalar operations
+	template <std::size_t Rows, std::size_t Columns, typename Scalar>
+	inline Matrix<Rows, Columns, Scalar> operator+(const Matrix<Rows, Columns, Scalar>& matrix, const typename Matrix<Rows, Columns, Scalar>::ScalarType scalar)
+	{
+		Matrix<Rows, Columns, Scalar> newMatrix(matrix);
+		newMatrix += scalar;
+
+		return newMatrix;
+	}
+
+	template <std::size_t Rows, std::size_t Columns, typename Scalar>
+	inline Matrix<Rows, Columns, Scalar> operator+(const typename Matrix<Rows, Columns, Scalar>::ScalarType scalar, const Matrix<Rows, Columns, Scalar>& matrix)
+	{
+		return matrix + scalar;
+	}
+
+	template <std::size_t Rows, std::size_t Columns, typename Scalar>
+	inline Matrix<Rows, Columns, Scalar> operator-(const Matrix<Rows, Columns, Scalar>& matrix, const typename Matrix<Rows, Columns, Scalar>::ScalarType scalar)
+	{
+		Matrix<Rows, Columns, Scalar> newMatrix(matrix);
+		newMatrix -= scalar;
+
+		return newMatrix;
+	}
+
+	template <std::size_t Rows, std::size_t Columns, typename Scalar>
+	inline Matrix<Rows, Columns, Scalar> operator-(const typename Matrix<Rows, Columns, Scalar>::ScalarType scalar, const Matrix<Rows, Columns, Scalar>& matrix)
+	{
+		return matrix - scalar;
+	}
+
+	template <std::size_t Rows, std::size_t Columns, typename Scalar>
+	inline Matrix<Rows, Columns, Scalar> operator*(const Matrix<Rows, Columns, Scalar>& matrix, const typename Matrix<Rows, Columns, Scalar>::ScalarType scalar)
+	{
+		Matrix<Rows, Columns, Scalar> newMatrix(matrix);
+		newMatrix *= scalar;
+
+		return newMatrix;
+	}
+
+	template <std::size_t Rows, std::size_t Columns, typename Scalar>
+	inline Matrix<Rows, Columns, Scalar> operator*(const typename Matrix<Rows, Columns, Scalar>::ScalarType scalar, const Matrix<Rows, Columns, Scalar>& matrix)
+	{
+		return matrix * scalar;
+	}
+
+	template <std::size_t Rows, std::size_t Columns, typename Scalar>
+	inline Matrix<Rows, Columns, Scalar> operator/(const Matrix<Rows, Columns, Scalar>& matrix, const typename Matrix<Rows, Columns, Scalar>::ScalarType scalar)
+	{
+		Matrix<Rows, Columns, Scalar> newMatrix(matrix);
+		newMatrix /= scalar;
+
+		return newMatrix;
+	}
+
+	template <std::size_t Rows, std::size_t Columns, typename Scalar>
+	inline Matrix<Rows, Columns, Scalar> operator/(const typename Matrix<Rows, Columns, Scalar>::ScalarType scalar, const Matrix<Rows, Columns, Scalar>& matrix)
+	{
+		return matrix / scalar;
+	}
+}
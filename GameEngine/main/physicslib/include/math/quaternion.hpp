@@ -1,9 +1,14 @@
 #pragma once
+#include <cmath>
 #include <string>
+#include <type_traits>
 #include "math/vector3.hpp"
 
 namespace physicslib
 {
+	/**
+	 * Quaternion (r, i, j, k)
+	 */
 	class Quaternion
 	{
 	public:
@@ -17,24 +22,19 @@ namespace physicslib
 		 * Constructor
 		 * Create a quaternion from 4 scalars
 		 */
-		Quaternion(double r, double i, double j, double k);
+		Quaternion(real r, real i, real j, real k);
 
 		/**
 		 * Constructor
 		 * Create a quaternion from a scalar and a vector3
 		 */
-		Quaternion(double r, Vector3 vector);
+		Quaternion(real r, Vector3 vector);
 
 		/**
 		 * Default copy constructor
 		 */
 		Quaternion(Quaternion const& anotherQuaternion) = default;
 
-		/**
-		 * Virtual destructor
-		 */
-		virtual ~Quaternion() = default;
-
 		/**
 		 * Default assignment operator
 		 */
@@ -46,9 +46,9 @@ namespace physicslib
 		Quaternion operator*(const Quaternion& anotherQuaternion) const;
 		Quaternion& operator+=(const Quaternion& anotherQuaternion);
 		Quaternion operator+(const Quaternion& anotherQuaternion) const;
-		Quaternion& operator*=(double scalar);
+		Quaternion& operator*=(real scalar);
 
-		double ScalarProduct(Quaternion const& anotherQuaternion) const;
+		real ScalarProduct(Quaternion const& anotherQuaternion) const;
 
 		/**
 		 * Do a rotation around the axis represented by vector
@@ -58,17 +58,17 @@ namespace physicslib
 		/**
 		 * Update the orientation quaternion by the angular velocity
 		 */
-		void updateOrientation(Vector3 vector, double frameTime);
+		void updateOrientation(Vector3 vector, real frameTime);
 
 		/**
 		 * Get the norm of the quaternion
 		 */
-		double getNorm() const;
+		real getNorm() const;
 
 		/**
 		 * Get the squared norm of the quaternion
 		 */
-		double getSquaredNorm() const;
+		real getSquaredNorm() const;
 
 		/**
 		 * Normalizes the quaternion
@@ -81,16 +81,16 @@ namespace physicslib
 		Quaternion getNormalizedQuaternion() const;
 
 		// Getters
-		double getR() const { return m_r; };
-		double getI() const { return m_i; };
-		double getJ() const { return m_j; };
-		double getK() const { return m_k; };
+		real getR() const { return m_r; };
+		real getI() const { return m_i; };
+		real getJ() const { return m_j; };
+		real getK() const { return m_k; };
 
 		// Setters
-		void setR(double newR) { m_r = newR; };
-		void setI(double newI) { m_i = newI; };
-		void setJ(double newJ) { m_j = newJ; };
-		void setK(double newK) { m_k = newK; };
+		void setR(real newR) { m_r = newR; };
+		void setI(real newI) { m_i = newI; };
+		void setJ(real newJ) { m_j = newJ; };
+		void setK(real newK) { m_k = newK; };
 
 		/**
 		 * Return the string representation of the quaternion
@@ -98,13 +98,162 @@ namespace physicslib
 		std::string toString() const;
 
 	private:
-		double m_r = 0;
-		double m_i = 0;
-		double m_j = 0;
-		double m_k = 0;
+		real m_r = 0;
+		real m_i = 0;
+		real m_j = 0;
+		real m_k = 0;
 	};
 
-	// Quaternion/scalar mathematical operations
-	Quaternion operator*(const Quaternion& quaternion, double scalar);
-	Quaternion operator*(double scalar, const Quaternion& quaternion);
+	// The arithmetic is defined inline: the components stay in registers from one operation to the next
+
+	inline Quaternion::Quaternion()
+		: m_r(1.)
+		, m_i(0.)
+		, m_j(0.)
+		, m_k(0.)
+	{
+	}
+
+	inline Quaternion::Quaternion(real r, real i, real j, real k)
+		: m_r(r)
+		, m_i(i)
+		, m_j(j)
+		, m_k(k)
+	{
+	}
+
+	inline Quaternion::Quaternion(real r, Vector3 vector)
+		: m_r(r)
+		, m_i(vector.getX())
+		, m_j(vector.getY())
+		, m_k(vector.getZ())
+	{
+	}
+
+	// ----------------------------------
+	// Quaternion mathematical operations
+	// ----------------------------------
+	inline Quaternion Quaternion::operator-() const
+	{
+		return Quaternion(-m_r, -m_i, -m_j, -m_k);
+	}
+
+	inline Quaternion& Quaternion::operator*=(const Quaternion& anotherQuaternion)
+	{
+		// Every component is computed from the original values of both operands
+		*this = Quaternion(
+			m_r * anotherQuaternion.m_r - m_i * anotherQuaternion.m_i - m_j * anotherQuaternion.m_j - m_k * anotherQuaternion.m_k,
+			m_r * anotherQuaternion.m_i + m_i * anotherQuaternion.m_r + m_j * anotherQuaternion.m_k - m_k * anotherQuaternion.m_j,
+			m_r * anotherQuaternion.m_j + m_j * anotherQuaternion.m_r + m_k * anotherQuaternion.m_i - m_i * anotherQuaternion.m_k,
+			m_r * anotherQuaternion.m_k + m_k * anotherQuaternion.m_r + m_i * anotherQuaternion.m_j - m_j * anotherQuaternion.m_i
+		);
+
+		return *this;
+	}
+
+	inline Quaternion Quaternion::operator*(const Quaternion& anotherQuaternion) const
+	{
+		Quaternion newQuaternion(*this);
+		newQuaternion *= anotherQuaternion;
+
+		return newQuaternion;
+	}
+
+	inline Quaternion& Quaternion::operator+=(const Quaternion& anotherQuaternion)
+	{
+		m_r += anotherQuaternion.m_r;
+		m_i += anotherQuaternion.m_i;
+		m_j += anotherQuaternion.m_j;
+		m_k += anotherQuaternion.m_k;
+
+		return *this;
+	}
+
+	inline Quaternion Quaternion::operator+(const Quaternion& anotherQuaternion) const
+	{
+		Quaternion newQuaternion(*this);
+		newQuaternion += anotherQuaternion;
+
+		return newQuaternion;
+	}
+
+	inline Quaternion& Quaternion::operator*=(real scalar)
+	{
+		m_r *= scalar;
+		m_i *= scalar;
+		m_j *= scalar;
+		m_k *= scalar;
+
+		return *this;
+	}
+
+	inline Quaternion operator*(const Quaternion& quaternion, real scalar)
+	{
+		Quaternion newQuaternion(quaternion);
+		newQuaternion *= scalar;
+
+		return newQuaternion;
+	}
+
+	inline Quaternion operator*(real scalar, const Quaternion& quaternion)
+	{
+		return quaternion * scalar;
+	}
+
+	inline real Quaternion::ScalarProduct(Quaternion const& anotherQuaternion) const
+	{
+		return m_r * anotherQuaternion.m_r + m_i * anotherQuaternion.m_i + m_j * anotherQuaternion.m_j + m_k * anotherQuaternion.m_k;
+	}
+
+	inline void Quaternion::rotate(Vector3 vector)
+	{
+		Quaternion q(0., vector);
+		Quaternion q2(q * (*this));
+		*this += q2;
+		normalize();
+	}
+
+	inline void Quaternion::updateOrientation(Vector3 vector, real frameTime)
+	{
+		Quaternion omega(0., vector);
+		(*this) += (frameTime / 2) * omega * (*this);
+		normalize();
+	}
+
+	inline real Quaternion::getNorm() const
+	{
+		return std::sqrt(getSquaredNorm());
+	}
+
+	inline real Quaternion::getSquaredNorm() const
+	{
+		return ScalarProduct(*this);
+	}
+
+	inline void Quaternion::normalize()
+	{
+		real squaredNorm = getSquaredNorm();
+		if (squaredNorm == 0)
+		{
+			(*this) = Quaternion(1., 0., 0., 0.);
+			return;
+		}
+
+		squaredNorm = 1 / std::sqrt(squaredNorm);
+		(*this) *= squaredNorm;
+	}
+
+	inline Quaternion Quaternion::getNormalizedQuaternion() const
+	{
+		Quaternion newQuaternion(*this);
+		newQuaternion.normalize();
+
+		return newQuaternion;
+	}
+
+	// Stable memory layout: 4 packed reals
+	static_assert(std::is_standard_layout<Quaternion>::value, "Quaternion must keep a standard layout");
+	static_assert(std::is_trivially_copyable<Quaternion>::value, "Quaternion must stay trivially copyable");
+	static_assert(sizeof(Quaternion) == 4 * sizeof(real), "Quaternion must not contain padding or hidden members");
+	static_assert(alignof(Quaternion) == alignof(real), "Quaternion must be aligned as a real");
 }
\ No newline at end of file
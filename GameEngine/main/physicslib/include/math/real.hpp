@@ -0,0 +1,31 @@
+#pragma once
+
+/*
+ * Scalar type of the physics library.
+ *
+ * The precision is picked at build time with the PHYSICSLIB_REAL CMake option:
+ *  - double (default)     : `real` is a double
+ *  - float                : `real` is a float, PHYSICSLIB_REAL_FLOAT is defined
+ * Float halves the memory traffic and fits twice as many lanes in a SIMD register,
+ * which is enough precision for our scene sizes.
+ */
+namespace physicslib
+{
+#if defined(PHYSICSLIB_REAL_FLOAT)
+	using real = float;
+#else
+	using real = double;
+#endif
+
+	/**
+	 * Return the name of the scalar type used by the build
+	 */
+	constexpr const char* getRealName()
+	{
+#if defined(PHYSICSLIB_REAL_FLOAT)
+		return "float";
+#else
+		return "double";
+#endif
+	}
+}
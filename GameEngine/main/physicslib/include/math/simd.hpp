@@ -0,0 +1,312 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include "math/real.hpp"
+
+/*
+ * SIMD backend of the math library.
+ *
+ * The backend is picked at build time with the PHYSICSLIB_SIMD CMake option:
+ *  - PHYSICSLIB_SIMD_AVX2   : one __m256d holds the 4 double lanes
+ *  - PHYSICSLIB_SIMD_SSE2   : a pair of __m128d holds the 4 double lanes
+ *  - PHYSICSLIB_SIMD_SCALAR : plain reals, used when no instruction set is available
+ * When none of them is defined, the best instruction set enabled in the compiler is used.
+ * With PHYSICSLIB_REAL_FLOAT, the 4 float lanes fit in a single __m128 for both AVX2 and SSE2.
+ *
+ * The kernels evaluate their operations in the same order as the scalar code,
+ * so every backend returns the same results as the scalar fallback (checked by tests/mathKernelsTest.cpp).
+ *
+ * Packing 3 or 4 values into a register costs more than the few operations done on them,
+ * so Vector3, Quaternion and the 3x3 matrices stay scalar and inline. Only the kernels that win
+ * use the backend: the composition of 3x4 matrices, where a row fills a register, and Transform::transformPoints.
+ */
+#if !defined(PHYSICSLIB_SIMD_AVX2) && !defined(PHYSICSLIB_SIMD_SSE2) && !defined(PHYSICSLIB_SIMD_SCALAR)
+	#if defined(__AVX2__)
+		#define PHYSICSLIB_SIMD_AVX2
+	#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+		#define PHYSICSLIB_SIMD_SSE2
+	#else
+		#define PHYSICSLIB_SIMD_SCALAR
+	#endif
+#endif
+
+#if defined(PHYSICSLIB_REAL_FLOAT) && !defined(PHYSICSLIB_SIMD_SCALAR)
+	#define PHYSICSLIB_SIMD_FLOAT4
+#endif
+
+#if defined(PHYSICSLIB_SIMD_AVX2)
+	#include <immintrin.h>
+#elif defined(PHYSICSLIB_SIMD_SSE2)
+	#include <emmintrin.h>
+#endif
+
+namespace physicslib
+{
+	namespace simd
+	{
+		// A register of 4 real lanes
+#if defined(PHYSICSLIB_SIMD_FLOAT4)
+		using Register = __m128;
+#elif defined(PHYSICSLIB_SIMD_AVX2)
+		using Register = __m256d;
+#elif defined(PHYSICSLIB_SIMD_SSE2)
+		struct Register
+		{
+			__m128d low;
+			__m128d high;
+		};
+#else
+		struct Register
+		{
+			real lanes[4];
+		};
+#endif
+
+		/**
+		 * Return the name of the backend used by the build
+		 */
+		constexpr const char* getBackendName()
+		{
+#if defined(PHYSICSLIB_SIMD_AVX2)
+			return "avx2";
+#elif defined(PHYSICSLIB_SIMD_SSE2)
+			return "sse2";
+#else
+			return "scalar";
+#endif
+		}
+
+		/**
+		 * Whether a register is a hardware register
+		 * The callers keep their plain scalar code when it is not, instead of going through the emulated lanes.
+		 */
+#if defined(PHYSICSLIB_SIMD_SCALAR)
+		constexpr bool IS_VECTORIZED = false;
+#else
+		constexpr bool IS_VECTORIZED = true;
+#endif
+
+#if defined(PHYSICSLIB_SIMD_FLOAT4)
+		/**
+		 * Immediate of _mm_shuffle_ps: lanes 0 and 1 come from the first operand, lanes 2 and 3 from the second
+		 * A variable template, so that it is a constant even when the compiler does not optimize.
+		 */
+		template <std::size_t I0, std::size_t I1, std::size_t I2, std::size_t I3>
+		constexpr int SHUFFLE_MASK = int(I0 | (I1 << 2) | (I2 << 4) | (I3 << 6));
+#endif
+
+		// -------------
+		// Loads/Stores
+		// -------------
+		inline Register set(real x, real y, real z, real w)
+		{
+#if defined(PHYSICSLIB_SIMD_FLOAT4)
+			return _mm_set_ps(w, z, y, x);
+#elif defined(PHYSICSLIB_SIMD_AVX2)
+			return _mm256_set_pd(w, z, y, x);
+#elif defined(PHYSICSLIB_SIMD_SSE2)
+			return { _mm_set_pd(y, x), _mm_set_pd(w, z) };
+#else
+			return { { x, y, z, w } };
+#endif
+		}
+
+		inline Register splat(real scalar)
+		{
+			return set(scalar, scalar, scalar, scalar);
+		}
+
+		inline Register load(const real* data)
+		{
+#if defined(PHYSICSLIB_SIMD_FLOAT4)
+			return _mm_loadu_ps(data);
+#elif defined(PHYSICSLIB_SIMD_AVX2)
+			return _mm256_loadu_pd(data);
+#elif defined(PHYSICSLIB_SIMD_SSE2)
+			return { _mm_loadu_pd(data), _mm_loadu_pd(data + 2) };
+#else
+			return { { data[0], data[1], data[2], data[3] } };
+#endif
+		}
+
+		inline void store(real* data, const Register& reg)
+		{
+#if defined(PHYSICSLIB_SIMD_FLOAT4)
+			_mm_storeu_ps(data, reg);
+#elif defined(PHYSICSLIB_SIMD_AVX2)
+			_mm256_storeu_pd(data, reg);
+#elif defined(PHYSICSLIB_SIMD_SSE2)
+			_mm_storeu_pd(data, reg.low);
+			_mm_storeu_pd(data + 2, reg.high);
+#else
+			std::memcpy(data, reg.lanes, 4 * sizeof(real));
+#endif
+		}
+
+		/**
+		 * Load the `count` first lanes (count <= 4), the others are set to 0
+		 * Never reads past `data + count`
+		 */
+		inline Register load(const real* data, std::size_t count)
+		{
+			real lanes[4] = { 0, 0, 0, 0 };
+			std::memcpy(lanes, data, count * sizeof(real));
+			return load(lanes);
+		}
+
+		/**
+		 * Store the `count` first lanes (count <= 4)
+		 * Never writes past `data + count`
+		 */
+		inline void store(real* data, const Register& reg, std::size_t count)
+		{
+			real lanes[4];
+			store(lanes, reg);
+			std::memcpy(data, lanes, count * sizeof(real));
+		}
+
+		template <std::size_t Lane>
+		inline real get(const Register& reg)
+		{
+			static_assert(Lane < 4, "A register only has 4 lanes");
+#if defined(PHYSICSLIB_SIMD_FLOAT4)
+			return _mm_cvtss_f32(_mm_shuffle_ps(reg, reg, (SHUFFLE_MASK<Lane, Lane, Lane, Lane>)));
+#elif defined(PHYSICSLIB_SIMD_AVX2)
+			__m128d half = (Lane < 2) ? _mm256_castpd256_pd128(reg) : _mm256_extractf128_pd(reg, 1);
+			return (Lane % 2 == 0) ? _mm_cvtsd_f64(half) : _mm_cvtsd_f64(_mm_unpackhi_pd(half, half));
+#elif defined(PHYSICSLIB_SIMD_SSE2)
+			__m128d half = (Lane < 2) ? reg.low : reg.high;
+			return (Lane % 2 == 0) ? _mm_cvtsd_f64(half) : _mm_cvtsd_f64(_mm_unpackhi_pd(half, half));
+#else
+			return reg.lanes[Lane];
+#endif
+		}
+
+		// ----------------------
+		// Arithmetic operations
+		// ----------------------
+		inline Register add(const Register& a, const Register& b)
+		{
+#if defined(PHYSICSLIB_SIMD_FLOAT4)
+			return _mm_add_ps(a, b);
+#elif defined(PHYSICSLIB_SIMD_AVX2)
+			return _mm256_add_pd(a, b);
+#elif defined(PHYSICSLIB_SIMD_SSE2)
+			return { _mm_add_pd(a.low, b.low), _mm_add_pd(a.high, b.high) };
+#else
+			return { { a.lanes[0] + b.lanes[0], a.lanes[1] + b.lanes[1], a.lanes[2] + b.lanes[2], a.lanes[3] + b.lanes[3] } };
+#endif
+		}
+
+		inline Register sub(const Register& a, const Register& b)
+		{
+#if defined(PHYSICSLIB_SIMD_FLOAT4)
+			return _mm_sub_ps(a, b);
+#elif defined(PHYSICSLIB_SIMD_AVX2)
+			return _mm256_sub_pd(a, b);
+#elif defined(PHYSICSLIB_SIMD_SSE2)
+			return { _mm_sub_pd(a.low, b.low), _mm_sub_pd(a.high, b.high) };
+#else
+			return { { a.lanes[0] - b.lanes[0], a.lanes[1] - b.lanes[1], a.lanes[2] - b.lanes[2], a.lanes[3] - b.lanes[3] } };
+#endif
+		}
+
+		inline Register mul(const Register& a, const Register& b)
+		{
+#if defined(PHYSICSLIB_SIMD_FLOAT4)
+			return _mm_mul_ps(a, b);
+#elif defined(PHYSICSLIB_SIMD_AVX2)
+			return _mm256_mul_pd(a, b);
+#elif defined(PHYSICSLIB_SIMD_SSE2)
+			return { _mm_mul_pd(a.low, b.low), _mm_mul_pd(a.high, b.high) };
+#else
+			return { { a.lanes[0] * b.lanes[0], a.lanes[1] * b.lanes[1], a.lanes[2] * b.lanes[2], a.lanes[3] * b.lanes[3] } };
+#endif
+		}
+
+		inline Register div(const Register& a, const Register& b)
+		{
+#if defined(PHYSICSLIB_SIMD_FLOAT4)
+			return _mm_div_ps(a, b);
+#elif defined(PHYSICSLIB_SIMD_AVX2)
+			return _mm256_div_pd(a, b);
+#elif defined(PHYSICSLIB_SIMD_SSE2)
+			return { _mm_div_pd(a.low, b.low), _mm_div_pd(a.high, b.high) };
+#else
+			return { { a.lanes[0] / b.lanes[0], a.lanes[1] / b.lanes[1], a.lanes[2] / b.lanes[2], a.lanes[3] / b.lanes[3] } };
+#endif
+		}
+
+		// -------------------
+		// Layout conversions
+		// -------------------
+
+		/**
+		 * Convert 4 packed (x, y, z) triplets into one register per coordinate
+		 * In:  a = (x0 y0 z0 x1), b = (y1 z1 x2 y2), c = (z2 x3 y3 z3)
+		 * Out: x = (x0 x1 x2 x3), y = (y0 y1 y2 y3), z = (z0 z1 z2 z3)
+		 */
+		inline void deinterleave3(const Register& a, const Register& b, const Register& c, Register& x, Register& y, Register& z)
+		{
+#if defined(PHYSICSLIB_SIMD_FLOAT4)
+			const __m128 x2x3 = _mm_shuffle_ps(b, c, (SHUFFLE_MASK<2, 2, 1, 1>));    // x2 x2 x3 x3
+			const __m128 y0y1 = _mm_shuffle_ps(a, b, (SHUFFLE_MASK<1, 1, 0, 0>));    // y0 y0 y1 y1
+			const __m128 y2y3 = _mm_shuffle_ps(b, c, (SHUFFLE_MASK<3, 3, 2, 2>));    // y2 y2 y3 y3
+			const __m128 z0z1 = _mm_shuffle_ps(a, b, (SHUFFLE_MASK<2, 2, 1, 1>));    // z0 z0 z1 z1
+			const __m128 z2z3 = _mm_shuffle_ps(c, c, (SHUFFLE_MASK<0, 0, 3, 3>));    // z2 z2 z3 z3
+			x = _mm_shuffle_ps(a, x2x3, (SHUFFLE_MASK<0, 3, 0, 2>));
+			y = _mm_shuffle_ps(y0y1, y2y3, (SHUFFLE_MASK<0, 2, 0, 2>));
+			z = _mm_shuffle_ps(z0z1, z2z3, (SHUFFLE_MASK<0, 2, 0, 2>));
+#elif defined(PHYSICSLIB_SIMD_AVX2)
+			const __m256d ab = _mm256_blend_pd(a, b, 0b1100);        // x0 y0 x2 y2
+			const __m256d ac = _mm256_permute2f128_pd(a, c, 0x21);   // z0 x1 z2 x3
+			const __m256d bc = _mm256_blend_pd(b, c, 0b1100);        // y1 z1 y3 z3
+			x = _mm256_shuffle_pd(ab, ac, 0b1010);
+			y = _mm256_shuffle_pd(ab, bc, 0b0101);
+			z = _mm256_shuffle_pd(ac, bc, 0b1010);
+#elif defined(PHYSICSLIB_SIMD_SSE2)
+			x = { _mm_shuffle_pd(a.low, a.high, 0b10), _mm_shuffle_pd(b.high, c.low, 0b10) };
+			y = { _mm_shuffle_pd(a.low, b.low, 0b01), _mm_shuffle_pd(b.high, c.high, 0b01) };
+			z = { _mm_shuffle_pd(a.high, b.low, 0b10), _mm_shuffle_pd(c.low, c.high, 0b10) };
+#else
+			x = { { a.lanes[0], a.lanes[3], b.lanes[2], c.lanes[1] } };
+			y = { { a.lanes[1], b.lanes[0], b.lanes[3], c.lanes[2] } };
+			z = { { a.lanes[2], b.lanes[1], c.lanes[0], c.lanes[3] } };
+#endif
+		}
+
+		/**
+		 * Inverse of deinterleave3: pack one register per coordinate into 4 (x, y, z) triplets
+		 */
+		inline void interleave3(const Register& x, const Register& y, const Register& z, Register& a, Register& b, Register& c)
+		{
+#if defined(PHYSICSLIB_SIMD_FLOAT4)
+			const __m128 x0y0 = _mm_shuffle_ps(x, y, (SHUFFLE_MASK<0, 0, 0, 0>));    // x0 x0 y0 y0
+			const __m128 z0x1 = _mm_shuffle_ps(z, x, (SHUFFLE_MASK<0, 0, 1, 1>));    // z0 z0 x1 x1
+			const __m128 y1z1 = _mm_shuffle_ps(y, z, (SHUFFLE_MASK<1, 1, 1, 1>));    // y1 y1 z1 z1
+			const __m128 x2y2 = _mm_shuffle_ps(x, y, (SHUFFLE_MASK<2, 2, 2, 2>));    // x2 x2 y2 y2
+			const __m128 z2x3 = _mm_shuffle_ps(z, x, (SHUFFLE_MASK<2, 2, 3, 3>));    // z2 z2 x3 x3
+			const __m128 y3z3 = _mm_shuffle_ps(y, z, (SHUFFLE_MASK<3, 3, 3, 3>));    // y3 y3 z3 z3
+			a = _mm_shuffle_ps(x0y0, z0x1, (SHUFFLE_MASK<0, 2, 0, 2>));
+			b = _mm_shuffle_ps(y1z1, x2y2, (SHUFFLE_MASK<0, 2, 0, 2>));
+			c = _mm_shuffle_ps(z2x3, y3z3, (SHUFFLE_MASK<0, 2, 0, 2>));
+#elif defined(PHYSICSLIB_SIMD_AVX2)
+			const __m256d xy = _mm256_shuffle_pd(x, y, 0b0000);      // x0 y0 x2 y2
+			const __m256d zx = _mm256_shuffle_pd(z, x, 0b1010);      // z0 x1 z2 x3
+			const __m256d yz = _mm256_shuffle_pd(y, z, 0b1111);      // y1 z1 y3 z3
+			a = _mm256_permute2f128_pd(xy, zx, 0x20);
+			b = _mm256_permute2f128_pd(yz, xy, 0x30);
+			c = _mm256_permute2f128_pd(zx, yz, 0x31);
+#elif defined(PHYSICSLIB_SIMD_SSE2)
+			a = { _mm_shuffle_pd(x.low, y.low, 0b00), _mm_shuffle_pd(z.low, x.low, 0b10) };
+			b = { _mm_shuffle_pd(y.low, z.low, 0b11), _mm_shuffle_pd(x.high, y.high, 0b00) };
+			c = { _mm_shuffle_pd(z.high, x.high, 0b10), _mm_shuffle_pd(y.high, z.high, 0b11) };
+#else
+			a = { { x.lanes[0], y.lanes[0], z.lanes[0], x.lanes[1] } };
+			b = { { y.lanes[1], z.lanes[1], x.lanes[2], y.lanes[2] } };
+			c = { { z.lanes[2], x.lanes[3], y.lanes[3], z.lanes[3] } };
+#endif
+		}
+	}
+}
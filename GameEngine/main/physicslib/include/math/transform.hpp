@@ -0,0 +1,31 @@
+#pragma once
+
+#include "span.hpp"
+#include "math/matrix3.hpp"
+#include "math/matrix34.hpp"
+#include "math/vector3.hpp"
+
+/*
+ * Batched transforms: apply one matrix to N points in a single call.
+ * The results are written in a buffer provided by the caller, which must hold
+ * as many points as the input (it can be the input buffer itself).
+ * Points are processed 4 at a time with the SIMD backend and give the same
+ * results as transforming them one by one.
+ */
+namespace physicslib
+{
+	/**
+	 * out[i] = matrix * points[i]
+	 */
+	void transformPoints(const Matrix3& matrix, Span<const Vector3> points, Span<Vector3> out);
+
+	/**
+	 * out[i] = matrix * points[i] + translation
+	 */
+	void transformPoints(const Matrix3& matrix, const Vector3& translation, Span<const Vector3> points, Span<Vector3> out);
+
+	/**
+	 * out[i] = matrix * points[i], the translation column of the matrix is applied
+	 */
+	void transformPoints(const Matrix34& matrix, Span<const Vector3> points, Span<Vector3> out);
+}
@@ -1,11 +1,20 @@
 #pragma once
 
+#include <cmath>
+#include <cstddef>
 #include <string>
+#include <type_traits>
+#include "math/real.hpp"
 
 namespace physicslib
 {
-	class Matrix3;
+	template <std::size_t Rows, std::size_t Columns, typename Scalar>
+	class Matrix;
+	using Matrix3 = Matrix<3, 3, real>;
 
+	/**
+	 * 3D vector
+	 */
 	class Vector3
 	{
 	public :
@@ -19,18 +28,13 @@ namespace physicslib
 		 * Constructor
 		 * Create a vector from 3 scalars
 		 */
-		Vector3(double x, double y, double z);
+		Vector3(real x, real y, real z);
 
 		/**
 		 * Default copy constructor
 		 */
 		Vector3(Vector3 const& anotherVector) = default;
 
-		/**
-		 * Virtual destructor
-		 */
-		virtual ~Vector3() = default;
-
 		/**
 		 * Default assignment operator
 		 */
@@ -42,31 +46,31 @@ namespace physicslib
 		Vector3 operator+(const Vector3& anotherVector) const;
 		Vector3& operator-=(const Vector3& anotherVector);
 		Vector3 operator-(const Vector3& anotherVector) const;
-		double operator*(const Vector3& anotherVector) const;
+		real operator*(const Vector3& anotherVector) const;
 		Vector3 operator^(const Vector3& anotherVector) const;
 
 		// Vector/scalar mathematical operations
-		Vector3& operator*=(double scalar);
-		Vector3& operator/=(double scalar);
+		Vector3& operator*=(real scalar);
+		Vector3& operator/=(real scalar);
 
 		// Functional equivalent to operators
 		Vector3 VectorAddition(const Vector3& anotherVectorv) const;
 		Vector3 VectorSubtraction(const Vector3& anotherVector) const;
-		Vector3 ScalarMultiplication(double scalar) const;
-		Vector3 ScalarDivision(double scalar) const;
-		double ScalarProduct(const Vector3& anotherVector)const;
+		Vector3 ScalarMultiplication(real scalar) const;
+		Vector3 ScalarDivision(real scalar) const;
+		real ScalarProduct(const Vector3& anotherVector)const;
 		Vector3 CrossProduct(const Vector3& anotherVector) const;
 		Vector3 ComponentProduct(const Vector3& anotherVector) const;
 
 		/**
 		 * Get the norm of the vector
 		 */
-		double getNorm() const;
+		real getNorm() const;
 
 		/**
 		 * Get the squared norm of the vector
 		 */
-		double getSquaredNorm() const;
+		real getSquaredNorm() const;
 
 		/**
 		 * Normalizes the vector
@@ -90,14 +94,14 @@ namespace physicslib
 		Vector3 worldToLocal(const Matrix3& transformMatrix) const;
 
 		// Getters
-		double getX() const { return m_x; };
-		double getY() const { return m_y; };
-		double getZ() const { return m_z; };
+		real getX() const { return m_x; };
+		real getY() const { return m_y; };
+		real getZ() const { return m_z; };
 
 		// Setters
-		void setX(double newX) { m_x = newX; };
-		void setY(double newY) { m_y = newY; };
-		void setZ(double newZ) { m_z = newZ; };
+		void setX(real newX) { m_x = newX; };
+		void setY(real newY) { m_y = newY; };
+		void setZ(real newZ) { m_z = newZ; };
 
 		/**
 		 * Return the string representation of the vector
@@ -105,14 +109,161 @@ namespace physicslib
 		std::string toString() const;
 
 	private:
-		double m_x = 0;
-		double m_y = 0;
-		double m_z = 0;
+		real m_x = 0;
+		real m_y = 0;
+		real m_z = 0;
 	};
 
+	// The arithmetic is defined inline: the coordinates stay in registers from one operation to the next
+
+	inline Vector3::Vector3()
+		: m_x(0.)
+		, m_y(0.)
+		, m_z(0.)
+	{
+	}
+
+	inline Vector3::Vector3(real x, real y, real z)
+		: m_x(x)
+		, m_y(y)
+		, m_z(z)
+	{
+	}
+
+	// ------------------------------
+	// Vector mathematical operations
+	// ------------------------------
+	inline Vector3 Vector3::operator-() const
+	{
+		return Vector3(-m_x, -m_y, -m_z);
+	}
+
+	inline Vector3& Vector3::operator+=(const Vector3& anotherVector)
+	{
+		m_x += anotherVector.m_x;
+		m_y += anotherVector.m_y;
+		m_z += anotherVector.m_z;
+		return *this;
+	}
+
+	inline Vector3 Vector3::operator+(const Vector3& anotherVector) const
+	{
+		Vector3 newVector(*this);
+		newVector += anotherVector;
+
+		return newVector;
+	}
+
+	inline Vector3& Vector3::operator-=(const Vector3& anotherVector)
+	{
+		m_x -= anotherVector.m_x;
+		m_y -= anotherVector.m_y;
+		m_z -= anotherVector.m_z;
+		return *this;
+	}
+
+	inline Vector3 Vector3::operator-(const Vector3& anotherVector) const
+	{
+		Vector3 newVector(*this);
+		newVector -= anotherVector;
+
+		return newVector;
+	}
+
+	inline real Vector3::operator*(const Vector3& anotherVector) const
+	{
+		return m_x * anotherVector.m_x + m_y * anotherVector.m_y + m_z * anotherVector.m_z;
+	}
+
+	inline Vector3 Vector3::operator^(const Vector3& anotherVector) const
+	{
+		return Vector3(
+			m_y * anotherVector.m_z - m_z * anotherVector.m_y,
+			m_z * anotherVector.m_x - m_x * anotherVector.m_z,
+			m_x * anotherVector.m_y - m_y * anotherVector.m_x
+		);
+	}
+
+	// -------------------------------------
 	// Vector/scalar mathematical operations
-	Vector3 operator*(const Vector3& vector, double scalar);
-	Vector3 operator*(double scalar, const Vector3& vector);
-	Vector3 operator/(const Vector3& vector, double scalar);
-	Vector3 operator/(double scalar, const Vector3& vector);
+	// -------------------------------------
+	inline Vector3& Vector3::operator*=(real scalar)
+	{
+		m_x *= scalar;
+		m_y *= scalar;
+		m_z *= scalar;
+		return *this;
+	}
+
+	inline Vector3 operator*(const Vector3& vector, real scalar)
+	{
+		Vector3 newVector(vector);
+		newVector *= scalar;
+
+		return newVector;
+	}
+
+	inline Vector3 operator*(real scalar, const Vector3& vector)
+	{
+		return vector * scalar;
+	}
+
+	inline Vector3& Vector3::operator/=(real scalar)
+	{
+		m_x /= scalar;
+		m_y /= scalar;
+		m_z /= scalar;
+		return *this;
+	}
+
+	inline Vector3 operator/(const Vector3& vector, real scalar)
+	{
+		Vector3 newVector(vector);
+		newVector /= scalar;
+
+		return newVector;
+	}
+
+	inline Vector3 operator/(real scalar, const Vector3& vector)
+	{
+		return vector / scalar;
+	}
+
+	inline Vector3 Vector3::ComponentProduct(const Vector3& anotherVector) const
+	{
+		return Vector3(m_x * anotherVector.m_x, m_y * anotherVector.m_y, m_z * anotherVector.m_z);
+	}
+
+	inline real Vector3::getNorm() const
+	{
+		return std::sqrt(getSquaredNorm());
+	}
+
+	inline real Vector3::getSquaredNorm() const
+	{
+		return (*this) * (*this);
+	}
+
+	inline void Vector3::normalize()
+	{
+		real norm = getNorm();
+		if (norm != 0)
+		{
+			(*this) /= norm;
+		}
+	}
+
+	inline Vector3 Vector3::getNormalizedVector() const
+	{
+		Vector3 newVector(*this);
+		newVector.normalize();
+
+		return newVector;
+	}
+
+	// Stable memory layout: 3 packed reals
+	static_assert(std::is_standard_layout<Vector3>::value, "Vector3 must keep a standard layout");
+	static_assert(std::is_trivially_copyable<Vector3>::value, "Vector3 must stay trivially copyable");
+	static_assert(sizeof(Vector3) == 3 * sizeof(real), "Vector3 must not contain padding or hidden members");
+	static_assert(alignof(Vector3) == alignof(real), "Vector3 must be aligned as a real");
 }
\ No newline at end of file
@@ -4,29 +4,49 @@
 #include "math/quaternion.hpp"
 #include "math/matrix34.hpp"
 #include "math/matrix3.hpp"
+#include "collisionShape.hpp"
+#include "integrator.hpp"
+#include "span.hpp"
+#include <array>
 #include <vector>
 
 namespace physicslib
 {
 	class RigidBody
 	{
+		friend class RigidBodyWorld;
+
 	public:
+		static const std::size_t BOX_VERTEX_COUNT = CollisionShape::BOX_VERTEX_COUNT; // The number of vertices of the triangles drawing the box
+
 		/**
 		 * Constructor
 		 * Create a box-shaped rigidBody
 		 */
 		RigidBody(
-			const double mass, const double angularDamping, const Vector3 boxSize,
+			const real mass, const real angularDamping, const Vector3 boxSize,
+			const Vector3 initialPosition = Vector3(), const Vector3 initialVelocity = Vector3(), const Vector3 initialAcceleration = Vector3(),
+			const Quaternion initialOrientation = Quaternion(), const Vector3 initialAngularVelocity = Vector3(), const Vector3 initialAngularAcceleration = Vector3()
+		);
+
+		/**
+		 * Constructor
+		 * Create a irregular-shaped rigidBody: the solid convex hull of `points`, given in world coordinates
+		 * The body is placed at the center of mass of the hull. To create many bodies of the same shape,
+		 * build the shape once with CollisionShape::createConvexHull() and use the shape constructor.
+		 */
+		RigidBody(
+			const real mass, const real angularDamping, const std::vector<Vector3>& points,
 			const Vector3 initialPosition = Vector3(), const Vector3 initialVelocity = Vector3(), const Vector3 initialAcceleration = Vector3(),
 			const Quaternion initialOrientation = Quaternion(), const Vector3 initialAngularVelocity = Vector3(), const Vector3 initialAngularAcceleration = Vector3()
 		);
 
 		/**
 		 * Constructor
-		 * Create a irregular-shaped rigidBody
+		 * Create a rigidBody of shape `shape`, whose precomputed inertia and bounds are copied
 		 */
 		RigidBody(
-			const double mass, const double angularDamping, const std::vector<Vector3>& points,
+			const real mass, const real angularDamping, const CollisionShape& shape,
 			const Vector3 initialPosition = Vector3(), const Vector3 initialVelocity = Vector3(), const Vector3 initialAcceleration = Vector3(),
 			const Quaternion initialOrientation = Quaternion(), const Vector3 initialAngularVelocity = Vector3(), const Vector3 initialAngularAcceleration = Vector3()
 		);
@@ -42,14 +62,16 @@ namespace physicslib
 		virtual ~RigidBody() = default;
 
 		/**
-		 * Integrate the position and orientation of the rigid body over time
+		 * Integrate the position and orientation of the rigid body over time with the scheme `integrator`
 		 */
-		void integrate(double frameTime);
+		void integrate(real frameTime, Integrator integrator = Integrator::SEMI_IMPLICIT_EULER);
 
 		/**
-		 * Compute transformation matrix and inertia tensor each frame
+		 * Update the transformation matrices and the world inertia tensor
+		 * Only the data invalidated since the last call (orientation or position change) is recomputed.
+		 * The getters call it themselves, calling it explicitly only moves the work to a chosen moment.
 		 */
-		void computeDerivedData();
+		void computeDerivedData() const;
 
 		/**
 		 * Apply a force to a point in the world
@@ -71,19 +93,28 @@ namespace physicslib
 		 * We first create all the vertices from the rigidBody position.
 		 * Then we apply the rotation to all the vertices.
 		 */
-		std::vector<double> getBoxVertices() const;
+		std::vector<real> getBoxVertices() const;
+
+		/**
+		 * Write the vertices of the cube representing the rigid body in `vertices`
+		 * `vertices` must hold BOX_VERTEX_COUNT points
+		 */
+		void getBoxVertices(Span<Vector3> vertices) const;
 
 		#pragma region Getters/Setters
 
 		// Getters
-		double getInverseMass() const;
+		real getInverseMass() const;
 		physicslib::Vector3 getPosition() const;
 		physicslib::Vector3 getVelocity() const;
 		physicslib::Vector3 getAcceleration() const;
 		physicslib::Quaternion getOrientation() const;
 		physicslib::Vector3 getAngularVelocity() const;
+		physicslib::Vector3 getForceAccumulator() const;
+		physicslib::Vector3 getTorqueAccumulator() const;
 
 		physicslib::Matrix3 getTransformMatrix() const;
+		physicslib::Matrix34 getWorldTransformMatrix() const;
 		physicslib::Vector3 getBoxSize() const;
 
 		// Setters
@@ -96,7 +127,7 @@ namespace physicslib
 		#pragma endregion
 
 	private:
-		double m_inverseMass;
+		real m_inverseMass;
 		physicslib::Vector3 m_position;
 		physicslib::Vector3 m_velocity;
 		physicslib::Vector3 m_acceleration;
@@ -105,18 +136,21 @@ namespace physicslib
 		physicslib::Vector3 m_angularVelocity;
 		physicslib::Vector3 m_angularAcceleration;
 		physicslib::Vector3 m_torqueAccumulator;
-		double m_angularDamping;
+		real m_angularDamping;
 		physicslib::Vector3 m_boxSize;
 
-		// Computed data
-		physicslib::Matrix3 m_transformMatrix;
 		physicslib::Matrix3 m_localInverseInertiaTensor;
-		physicslib::Matrix3 m_globalInverseInertiaTensor;
 
-		/*
-		 * Get the vertices of the cube representing the rigid body.
-		 * The coordinates are in the local space of the rigid body.
+		// Computed data, updated lazily by computeDerivedData()
+		mutable physicslib::Matrix3 m_transformMatrix;
+		mutable physicslib::Matrix3 m_globalInverseInertiaTensor;
+		mutable physicslib::Matrix34 m_worldTransformMatrix;
+		mutable bool m_isRotationDirty = true; // The orientation changed: m_transformMatrix and m_globalInverseInertiaTensor are outdated
+		mutable bool m_isWorldTransformDirty = true; // The orientation or the position changed: m_worldTransformMatrix is outdated
+
+		/**
+		 * Update m_transformMatrix and m_globalInverseInertiaTensor if the orientation changed
 		 */
-		std::vector<Vector3> getBoxLocalVertices() const;
+		void updateRotationData() const;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,321 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "collisionShapeRegistry.hpp"
+#include "math/matrix3.hpp"
+#include "math/matrix34.hpp"
+#include "math/quaternion.hpp"
+#include "math/vector3.hpp"
+#include "integrator.hpp"
+#include "rigidBody.hpp"
+#include "span.hpp"
+#include "workerPool.hpp"
+
+namespace physicslib
+{
+	/**
+	 * Stable reference to a body of a RigidBodyWorld
+	 * The generation tells apart a removed body from the body reusing its slot.
+	 */
+	struct RigidBodyHandle
+	{
+		static const std::uint32_t INVALID_SLOT = UINT32_MAX;
+
+		std::uint32_t slot = INVALID_SLOT;
+		std::uint32_t generation = 0;
+
+		bool operator==(const RigidBodyHandle& anotherHandle) const { return slot == anotherHandle.slot && generation == anotherHandle.generation; }
+		bool operator!=(const RigidBodyHandle& anotherHandle) const { return !(*this == anotherHandle); }
+	};
+
+	/**
+	 * Container of rigid bodies stored as a structure of arrays
+	 *
+	 * Each property of the bodies lives in its own contiguous array, so the loops over the bodies
+	 * (integration, forces, rendering) read memory linearly. The bodies are packed: they are addressed
+	 * by an index in [0, getSize()[ which changes when a body is removed, and by a handle which does not.
+	 * The derived data (transform matrices, world inertia tensor) is always up to date.
+	 *
+	 * The shape of a body (inertia, bounds, vertices) is the id of a shape of the world's CollisionShapeRegistry,
+	 * shared with the other bodies of the same shape.
+	 *
+	 * Bodies whose linear and angular speeds stay under the sleep thresholds for the sleep delay are put to sleep:
+	 * they are not integrated until they are woken up, by a force applied through addForce...(), a setter,
+	 * or setAwake() (e.g. on a contact). The force generators run through a ForceRegister skip them, unless
+	 * a generator ties them to an awake body, e.g. a spring.
+	 */
+	class RigidBodyWorld
+	{
+	public:
+		static const std::size_t INTEGRATION_CHUNK_SIZE = 1024; // Number of bodies integrated by a worker at a time
+		static constexpr real DEFAULT_SLEEP_LINEAR_SPEED = real(0.1); // Speed under which a body is at rest
+		static constexpr real DEFAULT_SLEEP_ANGULAR_SPEED = real(0.1); // Angular speed (rad/s) under which a body is at rest
+		static constexpr real DEFAULT_SLEEP_DELAY = real(0.5); // Time (s) a body has to stay at rest before sleeping
+
+		/**
+		 * Constructor
+		 */
+		RigidBodyWorld() = default;
+
+		/**
+		 * Add a body with the state of `rigidBody`, return its handle
+		 * The body gets the box shape of its box size.
+		 */
+		RigidBodyHandle add(const RigidBody& rigidBody);
+
+		/**
+		 * Add a body with the state of `rigidBody` and the shape `shape`, return its handle
+		 */
+		RigidBodyHandle add(const RigidBody& rigidBody, CollisionShapeId shape);
+
+		/**
+		 * Add a body of shape `shape`, return its handle
+		 * Nothing is computed but the derived data: it is the cheapest way to spawn many bodies of a shape.
+		 */
+		RigidBodyHandle add(
+			CollisionShapeId shape, real mass, real angularDamping,
+			const Vector3& position = Vector3(), const Vector3& velocity = Vector3(),
+			const Quaternion& orientation = Quaternion(), const Vector3& angularVelocity = Vector3()
+		);
+
+		/**
+		 * Remove a body, the last body takes its index
+		 */
+		void remove(RigidBodyHandle handle);
+
+		/**
+		 * Remove all the bodies, their handles become invalid
+		 */
+		void clear();
+
+		/**
+		 * Reserve the memory for `capacity` bodies
+		 */
+		void reserve(std::size_t capacity);
+
+		/**
+		 * Return true if the handle refers to a body of the world
+		 */
+		bool isValid(RigidBodyHandle handle) const;
+
+		/**
+		 * Get the index of a valid handle
+		 */
+		std::size_t getIndex(RigidBodyHandle handle) const;
+
+		/**
+		 * Get the handle of the body at `index`
+		 */
+		RigidBodyHandle getHandle(std::size_t index) const;
+
+		/**
+		 * Get the number of bodies
+		 */
+		std::size_t getSize() const;
+
+		/**
+		 * Integrate the position and orientation of all the bodies over time and clear their accumulators
+		 * The bodies are integrated with the scheme set by setIntegrator().
+		 */
+		void integrate(real frameTime);
+
+		/**
+		 * Same as integrate(frameTime), with the bodies split in chunks run by `workerPool`
+		 * Each body only reads and writes its own data, so the results are identical to the serial version.
+		 */
+		void integrate(real frameTime, WorkerPool& workerPool);
+
+		/**
+		 * Return true if the body at `index` is integrated, false if it sleeps
+		 */
+		bool isAwake(std::size_t index) const;
+
+		/**
+		 * Wake up or put to sleep the body at `index`
+		 * A body put to sleep loses its velocities and keeps its last accelerations, a body woken up starts a new rest period.
+		 */
+		void setAwake(std::size_t index, bool isAwake);
+
+		/**
+		 * Get the number of bodies which are awake
+		 */
+		std::size_t getAwakeCount() const;
+
+		/**
+		 * Set the speeds under which a body is at rest, and how long it has to rest before sleeping
+		 * A delay of zero or less disables sleeping.
+		 */
+		void setSleepParameters(real linearSpeed, real angularSpeed, real delay);
+
+		/**
+		 * Apply a force to the center of mass of a body, the body wakes up
+		 */
+		void addForce(std::size_t index, const Vector3& force);
+
+		/**
+		 * Apply a torque to a body, the body wakes up
+		 */
+		void addTorque(std::size_t index, const Vector3& torque);
+
+		/**
+		 * Apply a force to a point in the world, the body wakes up
+		 */
+		void addForceAtPoint(std::size_t index, const Vector3& force, const Vector3& point);
+
+		/**
+		 * Apply a force to a point in the body, the body wakes up
+		 */
+		void addForceAtBodyPoint(std::size_t index, const Vector3& force, const Vector3& point);
+
+		/**
+		 * Write the vertices of the cubes representing all the bodies in `vertices`
+		 * `vertices` must hold getSize() * RigidBody::BOX_VERTEX_COUNT points
+		 * `interpolation` places the bodies between their state before the last integration (0) and their current state (1),
+		 * so that the rendering stays smooth when the simulation runs at a different rate.
+		 */
+		void getBoxVertices(Span<Vector3> vertices, real interpolation = 1) const;
+
+		/**
+		 * Get a copy of the body at `index` as a RigidBody, with empty accumulators
+		 */
+		RigidBody getRigidBody(std::size_t index) const;
+
+		#pragma region Getters/Setters
+
+		// Getters
+		real getInverseMass(std::size_t index) const;
+		Vector3 getPosition(std::size_t index) const;
+		Vector3 getVelocity(std::size_t index) const;
+		Vector3 getAcceleration(std::size_t index) const;
+		Quaternion getOrientation(std::size_t index) const;
+		Vector3 getAngularVelocity(std::size_t index) const;
+
+		Matrix3 getTransformMatrix(std::size_t index) const;
+		Matrix34 getWorldTransformMatrix(std::size_t index) const;
+		Vector3 getBoxSize(std::size_t index) const;
+		CollisionShapeId getCollisionShapeId(std::size_t index) const;
+		Span<const CollisionShapeId> getCollisionShapeIds() const;
+		CollisionShapeRegistry& getCollisionShapes();
+		const CollisionShapeRegistry& getCollisionShapes() const;
+
+		Span<const real> getInverseMasses() const;
+		Span<const Vector3> getPositions() const;
+		Span<const Vector3> getVelocities() const;
+		Span<const Quaternion> getOrientations() const;
+		Span<const Vector3> getAngularVelocities() const;
+		Span<const Matrix34> getWorldTransformMatrices() const;
+		Integrator getIntegrator() const;
+
+		// Accumulators written in place by the force generators, the bodies do not wake up
+		Span<Vector3> getForceAccumulators();
+		Span<Vector3> getTorqueAccumulators();
+
+		// Setters, the body wakes up
+		void setPosition(std::size_t index, Vector3 position);
+		void setVelocity(std::size_t index, Vector3 velocity);
+		void setOrientation(std::size_t index, Quaternion orientation);
+		void setAngularVelocity(std::size_t index, Vector3 angularVelocity);
+		void setIntegrator(Integrator integrator);
+
+		#pragma endregion
+
+	private:
+		struct Slot
+		{
+			std::uint32_t index; // Index of the body, INVALID_SLOT when the slot is free
+			std::uint32_t generation;
+		};
+
+		std::vector<Slot> m_slots;
+		std::vector<std::uint32_t> m_freeSlots;
+		std::vector<std::uint32_t> m_slotsByIndex; // Slot of each body, to update it when the body moves
+
+		// Properties of the bodies, one array each
+		std::vector<real> m_inverseMasses;
+		std::vector<real> m_angularDampings;
+		std::vector<Vector3> m_positions;
+		std::vector<Vector3> m_velocities;
+		std::vector<Vector3> m_accelerations;
+		std::vector<Vector3> m_forceAccumulators;
+		std::vector<Quaternion> m_orientations;
+		std::vector<Vector3> m_angularVelocities;
+		std::vector<Vector3> m_angularAccelerations;
+		std::vector<Vector3> m_torqueAccumulators;
+		std::vector<CollisionShapeId> m_shapeIds;
+		std::vector<std::uint8_t> m_awakeFlags; // Bytes rather than bits: the integration chunks write them concurrently
+		std::vector<real> m_restTimes; // Time spent under the sleep thresholds
+
+		CollisionShapeRegistry m_collisionShapes;
+
+		real m_sleepLinearSpeed = DEFAULT_SLEEP_LINEAR_SPEED;
+		real m_sleepAngularSpeed = DEFAULT_SLEEP_ANGULAR_SPEED;
+		real m_sleepDelay = DEFAULT_SLEEP_DELAY;
+		Integrator m_integrator = Integrator::SEMI_IMPLICIT_EULER;
+
+		// State before the last integration, for the interpolated rendering
+		std::vector<Vector3> m_previousPositions;
+		std::vector<Quaternion> m_previousOrientations;
+
+		// Derived data, updated with the orientations and positions
+		std::vector<Matrix3> m_transformMatrices;
+		std::vector<Matrix3> m_globalInverseInertiaTensors;
+		std::vector<Matrix34> m_worldTransformMatrices;
+
+		/**
+		 * Call `function` on each array of body properties
+		 */
+		template <typename Function>
+		void forEachArray(Function function)
+		{
+			function(m_slotsByIndex);
+			function(m_inverseMasses);
+			function(m_angularDampings);
+			function(m_positions);
+			function(m_velocities);
+			function(m_accelerations);
+			function(m_forceAccumulators);
+			function(m_orientations);
+			function(m_angularVelocities);
+			function(m_angularAccelerations);
+			function(m_torqueAccumulators);
+			function(m_shapeIds);
+			function(m_awakeFlags);
+			function(m_restTimes);
+			function(m_previousPositions);
+			function(m_previousOrientations);
+			function(m_transformMatrices);
+			function(m_globalInverseInertiaTensors);
+			function(m_worldTransformMatrices);
+		}
+
+		/**
+		 * Add a body at rest with empty accumulators, return its index
+		 */
+		std::size_t insert(
+			CollisionShapeId shape, real inverseMass, real angularDamping, const Vector3& position, const Vector3& velocity, const Vector3& acceleration,
+			const Quaternion& orientation, const Vector3& angularVelocity, const Vector3& angularAcceleration
+		);
+
+		/**
+		 * Integrate the bodies in [begin, end[
+		 */
+		void integrate(real frameTime, std::size_t begin, std::size_t end);
+
+		/**
+		 * Integrate the bodies in [begin, end[ with the integrator policy `Policy`
+		 */
+		template <typename Policy>
+		void integrate(real frameTime, std::size_t begin, std::size_t end);
+
+		/**
+		 * Update the rest time of the awake body at `index` and put it to sleep when it has rested long enough
+		 */
+		void updateSleep(std::size_t index, real frameTime);
+
+		/**
+		 * Recompute the derived data of the body at `index` from its orientation and position
+		 */
+		void computeDerivedData(std::size_t index);
+	};
+}
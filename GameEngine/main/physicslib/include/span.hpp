@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace physicslib
+{
+	/**
+	 * Non-owning view over a contiguous sequence of objects
+	 * Minimal C++17 stand-in for std::span: the caller keeps ownership of the memory
+	 * and must keep it alive while the span is used.
+	 */
+	template <typename T>
+	class Span
+	{
+	public:
+		/**
+		 * Default constructor
+		 * Create an empty span
+		 */
+		constexpr Span() = default;
+
+		/**
+		 * Create a span over `size` objects starting at `data`
+		 */
+		constexpr Span(T* data, std::size_t size)
+			: m_data(data)
+			, m_size(size)
+		{
+		}
+
+		/**
+		 * Create a span over a C array
+		 */
+		template <std::size_t Size>
+		constexpr Span(T (&array)[Size])
+			: m_data(array)
+			, m_size(Size)
+		{
+		}
+
+		/**
+		 * Create a span over a contiguous container (std::vector, std::array...)
+		 */
+		template <typename Container, typename = std::enable_if_t<
+			std::is_convertible<decltype(std::declval<Container&>().data()), T*>::value>>
+		constexpr Span(Container& container)
+			: m_data(container.data())
+			, m_size(container.size())
+		{
+		}
+
+		/**
+		 * Create a read-only span from a mutable one
+		 */
+		template <typename U, typename = std::enable_if_t<std::is_convertible<U(*)[], T(*)[]>::value>>
+		constexpr Span(const Span<U>& anotherSpan)
+			: m_data(anotherSpan.data())
+			, m_size(anotherSpan.size())
+		{
+		}
+
+		/**
+		 * Return the span of the `count` objects starting at `offset`
+		 */
+		constexpr Span subspan(std::size_t offset, std::size_t count) const
+		{
+			return Span(m_data + offset, count);
+		}
+
+		// Getters
+		constexpr T* data() const { return m_data; };
+		constexpr std::size_t size() const { return m_size; };
+		constexpr bool empty() const { return m_size == 0; };
+		constexpr T& operator[](std::size_t index) const { return m_data[index]; };
+
+		// Iterators
+		constexpr T* begin() const { return m_data; };
+		constexpr T* end() const { return m_data + m_size; };
+
+	private:
+		T* m_data = nullptr;
+		std::size_t m_size = 0;
+	};
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace physicslib
+{
+	/**
+	 * Pool of worker threads running chunked parallel loops
+	 *
+	 * The threads are created once and sleep between the loops. A loop over [0, count[ is cut into chunks of
+	 * `chunkSize` iterations, which the workers and the calling thread take in turn until none is left.
+	 * The function is called once per chunk, on disjoint ranges: as long as the iterations are independent,
+	 * the results do not depend on the number of threads nor on the scheduling.
+	 * One loop runs at a time, parallelFor() must not be called from inside a loop.
+	 */
+	class WorkerPool
+	{
+	public:
+		/**
+		 * Constructor
+		 * `threadCount` counts the calling thread, 0 uses one thread per hardware thread.
+		 * With a single thread the loops run serially on the calling thread.
+		 */
+		explicit WorkerPool(std::size_t threadCount = 0);
+
+		/**
+		 * Destructor, wait for the workers to stop
+		 */
+		~WorkerPool();
+
+		WorkerPool(const WorkerPool& anotherWorkerPool) = delete;
+		WorkerPool& operator=(const WorkerPool& anotherWorkerPool) = delete;
+
+		/**
+		 * Call `function(begin, end)` on chunks covering [0, count[ and return when all the chunks are done
+		 */
+		template <typename Function>
+		void parallelFor(std::size_t count, std::size_t chunkSize, const Function& function)
+		{
+			run(count, chunkSize, [](const void* context, std::size_t begin, std::size_t end)
+			{
+				(*static_cast<const Function*>(context))(begin, end);
+			}, &function);
+		}
+
+		/**
+		 * Get the number of threads running the loops, the calling thread included
+		 */
+		std::size_t getThreadCount() const;
+
+	private:
+		using ChunkFunction = void (*)(const void* context, std::size_t begin, std::size_t end);
+
+		std::vector<std::thread> m_workers;
+		std::mutex m_mutex;
+		std::condition_variable m_jobCondition; // Signaled when a loop starts or the pool stops
+		std::condition_variable m_doneCondition; // Signaled when the last worker leaves a loop
+		std::uint64_t m_jobId = 0;
+		std::size_t m_busyWorkerCount = 0;
+		bool m_isStopping = false;
+
+		// Current loop
+		ChunkFunction m_function = nullptr;
+		const void* m_context = nullptr;
+		std::size_t m_count = 0;
+		std::size_t m_chunkSize = 1;
+		std::atomic<std::size_t> m_nextChunk { 0 };
+
+		/**
+		 * Run a loop on the workers and the calling thread
+		 */
+		void run(std::size_t count, std::size_t chunkSize, ChunkFunction function, const void* context);
+
+		/**
+		 * Take chunks of the current loop until none is left
+		 */
+		void runChunks();
+
+		/**
+		 * Main function of the worker threads
+		 */
+		void workerLoop();
+	};
+}
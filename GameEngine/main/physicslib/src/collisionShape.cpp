@@ -0,0 +1,194 @@
+#include "collisionShape.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include "convexHull.hpp"
+#include "massProperties.hpp"
+
+namespace physicslib
+{
+	CollisionShape::CollisionShape(const Matrix3& inverseInertiaTensor, const Vector3& boxSize, const Vector3& centerOfMass, real volume)
+		: m_inverseInertiaTensor(inverseInertiaTensor)
+		, m_boxSize(boxSize)
+		, m_centerOfMass(centerOfMass)
+		, m_volume(volume)
+		, m_vertices(getBoxLocalVertices(boxSize))
+	{
+	}
+
+	CollisionShape CollisionShape::createBox(const Vector3& boxSize)
+	{
+		return CollisionShape(getBoxInverseInertiaTensor(boxSize), boxSize, Vector3(), boxSize.getX() * boxSize.getY() * boxSize.getZ());
+	}
+
+	CollisionShape CollisionShape::createPointCloud(const std::vector<Vector3>& points)
+	{
+		real xInertia = 0.;
+		real yInertia = 0.;
+		real zInertia = 0.;
+
+		real xyInertia = 0.;
+		real yzInertia = 0.;
+		real xzInertia = 0.;
+
+		// Half size of the bounds, centered on the center of mass
+		real xHalfSize = 0.;
+		real yHalfSize = 0.;
+		real zHalfSize = 0.;
+		for (const Vector3& point : points)
+		{
+			const real x = point.getX();
+			const real y = point.getY();
+			const real z = point.getZ();
+
+			// Compute moment of inertia
+			xInertia += y * y + z * z;
+			yInertia += x * x + z * z;
+			zInertia += x * x + y * y;
+
+			// Compute inertia product
+			xyInertia += x * y;
+			xzInertia += x * z;
+			yzInertia += y * z;
+
+			xHalfSize = std::max(xHalfSize, std::abs(x));
+			yHalfSize = std::max(yHalfSize, std::abs(y));
+			zHalfSize = std::max(zHalfSize, std::abs(z));
+		}
+
+		// The unit mass is shared between the points
+		Matrix3 inertiaTensor({
+			xInertia, -xyInertia, -xzInertia,
+			-xyInertia, yInertia, -yzInertia,
+			-xzInertia, -yzInertia, zInertia
+		});
+		inertiaTensor /= points.size();
+
+		return CollisionShape(inertiaTensor.getReverseMatrix(), Vector3(2 * xHalfSize, 2 * yHalfSize, 2 * zHalfSize));
+	}
+
+	CollisionShape CollisionShape::createMesh(const std::vector<Vector3>& vertices, const std::vector<std::uint32_t>& indices)
+	{
+		const MassProperties properties = computeMassProperties(vertices, indices);
+
+		// Half size of the bounds, centered on the center of mass
+		real xHalfSize = 0.;
+		real yHalfSize = 0.;
+		real zHalfSize = 0.;
+		for (const Vector3& vertex : vertices)
+		{
+			const Vector3 point = vertex - properties.centerOfMass;
+			xHalfSize = std::max(xHalfSize, std::abs(point.getX()));
+			yHalfSize = std::max(yHalfSize, std::abs(point.getY()));
+			zHalfSize = std::max(zHalfSize, std::abs(point.getZ()));
+		}
+
+		// The tensor of a unit mass is the tensor of a unit density divided by the volume
+		return CollisionShape((properties.inertiaTensor / properties.volume).getReverseMatrix(),
+			Vector3(2 * xHalfSize, 2 * yHalfSize, 2 * zHalfSize), properties.centerOfMass, properties.volume);
+	}
+
+	CollisionShape CollisionShape::createConvexHull(const std::vector<Vector3>& points)
+	{
+		const std::vector<std::uint32_t> indices = computeConvexHull(points);
+		if (indices.empty())
+		{
+			return createPointCloud(points);
+		}
+
+		return createMesh(points, indices);
+	}
+
+	Matrix3 CollisionShape::getBoxInverseInertiaTensor(const Vector3& boxSize)
+	{
+		const real k = real(1) / 12;
+		return Matrix3({
+			k * (boxSize.getY() * boxSize.getY() + boxSize.getZ() * boxSize.getZ()), 0, 0,
+			0, k * (boxSize.getX() * boxSize.getX() + boxSize.getZ() * boxSize.getZ()), 0,
+			0, 0, k * (boxSize.getX() * boxSize.getX() + boxSize.getY() * boxSize.getY())
+		}).getReverseMatrix();
+	}
+
+	std::array<Vector3, CollisionShape::BOX_VERTEX_COUNT> CollisionShape::getBoxLocalVertices(const Vector3& boxSize)
+	{
+		std::array<Vector3, BOX_VERTEX_COUNT> vertices =
+		{ {
+			{ - boxSize.getX() / 2,  - boxSize.getY() / 2,  - boxSize.getZ() / 2 },
+			{ + boxSize.getX() / 2,  - boxSize.getY() / 2,  - boxSize.getZ() / 2 },
+			{ + boxSize.getX() / 2,  + boxSize.getY() / 2,  - boxSize.getZ() / 2 },
+			{ + boxSize.getX() / 2,  + boxSize.getY() / 2,  - boxSize.getZ() / 2 },
+			{ - boxSize.getX() / 2,  + boxSize.getY() / 2,  - boxSize.getZ() / 2 },
+			{ - boxSize.getX() / 2,  - boxSize.getY() / 2,  - boxSize.getZ() / 2 },
+
+			{ - boxSize.getX() / 2,  - boxSize.getY() / 2,  + boxSize.getZ() / 2 },
+			{ + boxSize.getX() / 2,  - boxSize.getY() / 2,  + boxSize.getZ() / 2 },
+			{ + boxSize.getX() / 2,  + boxSize.getY() / 2,  + boxSize.getZ() / 2 },
+			{ + boxSize.getX() / 2,  + boxSize.getY() / 2,  + boxSize.getZ() / 2 },
+			{ - boxSize.getX() / 2,  + boxSize.getY() / 2,  + boxSize.getZ() / 2 },
+			{ - boxSize.getX() / 2,  - boxSize.getY() / 2,  + boxSize.getZ() / 2 },
+
+			{ - boxSize.getX() / 2,  + boxSize.getY() / 2,  + boxSize.getZ() / 2 },
+			{ - boxSize.getX() / 2,  + boxSize.getY() / 2,  - boxSize.getZ() / 2 },
+			{ - boxSize.getX() / 2,  - boxSize.getY() / 2,  - boxSize.getZ() / 2 },
+			{ - boxSize.getX() / 2,  - boxSize.getY() / 2,  - boxSize.getZ() / 2 },
+			{ - boxSize.getX() / 2,  - boxSize.getY() / 2,  + boxSize.getZ() / 2 },
+			{ - boxSize.getX() / 2,  + boxSize.getY() / 2,  + boxSize.getZ() / 2 },
+
+			{ + boxSize.getX() / 2,  + boxSize.getY() / 2,  + boxSize.getZ() / 2 },
+			{ + boxSize.getX() / 2,  + boxSize.getY() / 2,  - boxSize.getZ() / 2 },
+			{ + boxSize.getX() / 2,  - boxSize.getY() / 2,  - boxSize.getZ() / 2 },
+			{ + boxSize.getX() / 2,  - boxSize.getY() / 2,  - boxSize.getZ() / 2 },
+			{ + boxSize.getX() / 2,  - boxSize.getY() / 2,  + boxSize.getZ() / 2 },
+			{ + boxSize.getX() / 2,  + boxSize.getY() / 2,  + boxSize.getZ() / 2 },
+
+			{ - boxSize.getX() / 2,  - boxSize.getY() / 2,  - boxSize.getZ() / 2 },
+			{ + boxSize.getX() / 2,  - boxSize.getY() / 2,  - boxSize.getZ() / 2 },
+			{ + boxSize.getX() / 2,  - boxSize.getY() / 2,  + boxSize.getZ() / 2 },
+			{ + boxSize.getX() / 2,  - boxSize.getY() / 2,  + boxSize.getZ() / 2 },
+			{ - boxSize.getX() / 2,  - boxSize.getY() / 2,  + boxSize.getZ() / 2 },
+			{ - boxSize.getX() / 2,  - boxSize.getY() / 2,  - boxSize.getZ() / 2 },
+
+			{ - boxSize.getX() / 2,  + boxSize.getY() / 2,  - boxSize.getZ() / 2},
+			{ + boxSize.getX() / 2,  + boxSize.getY() / 2,  - boxSize.getZ() / 2},
+			{ + boxSize.getX() / 2,  + boxSize.getY() / 2,  + boxSize.getZ() / 2},
+			{ + boxSize.getX() / 2,  + boxSize.getY() / 2,  + boxSize.getZ() / 2},
+			{ - boxSize.getX() / 2,  + boxSize.getY() / 2,  + boxSize.getZ() / 2},
+			{ - boxSize.getX() / 2,  + boxSize.getY() / 2,  - boxSize.getZ() / 2},
+		} };
+		return vertices;
+	}
+
+	Matrix3 CollisionShape::getLocalInverseInertiaTensor(real inverseMass) const
+	{
+		return m_inverseInertiaTensor * inverseMass;
+	}
+
+	#pragma region Getters
+
+	const Matrix3& CollisionShape::getInverseInertiaTensor() const
+	{
+		return m_inverseInertiaTensor;
+	}
+
+	const Vector3& CollisionShape::getBoxSize() const
+	{
+		return m_boxSize;
+	}
+
+	const Vector3& CollisionShape::getCenterOfMass() const
+	{
+		return m_centerOfMass;
+	}
+
+	real CollisionShape::getVolume() const
+	{
+		return m_volume;
+	}
+
+	Span<const Vector3> CollisionShape::getVertices() const
+	{
+		return m_vertices;
+	}
+
+	#pragma endregion
+}
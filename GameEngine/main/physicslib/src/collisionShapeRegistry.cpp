@@ -0,0 +1,37 @@
+#include "collisionShapeRegistry.hpp"
+
+#include <cassert>
+
+namespace physicslib
+{
+	CollisionShapeId CollisionShapeRegistry::addBox(const Vector3& boxSize)
+	{
+		const std::array<real, 3> key = { boxSize.getX(), boxSize.getY(), boxSize.getZ() };
+		auto box = m_boxes.find(key);
+		if (box != m_boxes.end())
+		{
+			return box->second;
+		}
+
+		const CollisionShapeId id = add(CollisionShape::createBox(boxSize));
+		m_boxes.emplace(key, id);
+		return id;
+	}
+
+	CollisionShapeId CollisionShapeRegistry::add(const CollisionShape& shape)
+	{
+		m_shapes.push_back(shape);
+		return static_cast<CollisionShapeId>(m_shapes.size() - 1);
+	}
+
+	const CollisionShape& CollisionShapeRegistry::get(CollisionShapeId id) const
+	{
+		assert(id < m_shapes.size());
+		return m_shapes[id];
+	}
+
+	std::size_t CollisionShapeRegistry::getSize() const
+	{
+		return m_shapes.size();
+	}
+}
@@ -1,6 +1,8 @@
 #include "collisions/boxPrimitive.hpp"
 
+#include <cmath>
 #include <math.h>
+#include "math/transform.hpp"
 
 namespace physicslib
 {
@@ -10,9 +12,28 @@ namespace physicslib
 	{
 	}
 
+	BoxPrimitive::BoxPrimitive(const Matrix34& transformMatrix, const Vector3& boxSize)
+		: Primitive(transformMatrix)
+		, m_halfSizes(boxSize / 2.)
+	{
+	}
+
 	std::vector<Vector3> BoxPrimitive::getVertices() const
 	{
-		std::vector<Vector3> vertices {
+		std::vector<Vector3> vertices(VERTEX_COUNT);
+		getVertices(vertices);
+
+		return vertices;
+	}
+
+	std::size_t BoxPrimitive::getVertexCount() const
+	{
+		return VERTEX_COUNT;
+	}
+
+	void BoxPrimitive::getVertices(Span<Vector3> vertices) const
+	{
+		const Vector3 localVertices[VERTEX_COUNT] {
 			{ +m_halfSizes.getX(), +m_halfSizes.getY(), +m_halfSizes.getZ() },
 			{ -m_halfSizes.getX(), +m_halfSizes.getY(), +m_halfSizes.getZ() },
 			{ -m_halfSizes.getX(), -m_halfSizes.getY(), +m_halfSizes.getZ() },
@@ -23,20 +44,23 @@ namespace physicslib
 			{ +m_halfSizes.getX(), -m_halfSizes.getY(), -m_halfSizes.getZ() }
 		};
 
-		Matrix3 transform({
-			m_transformMatrix(0, 0), m_transformMatrix(0, 1), m_transformMatrix(0, 2),
-			m_transformMatrix(1, 0), m_transformMatrix(1, 1), m_transformMatrix(1, 2),
-			m_transformMatrix(2, 0), m_transformMatrix(2, 1), m_transformMatrix(2, 2)
-		});
-
-		Vector3 position = m_rigidBody->getPosition();
+		transformPoints(m_transformMatrix, localVertices, vertices);
+	}
 
-		std::transform(vertices.begin(), vertices.end(), vertices.begin(),
-			[&transform, &position](const Vector3& vertex)
-			{
-				return vertex.localToWorld(transform) + position;
-			});
+	BoundingBox BoxPrimitive::getBoundingBox() const
+	{
+		// The extent on an axis sums the projections of the half sizes of the rotated box on it
+		real extents[3];
+		for (std::size_t row = 0; row < 3; ++row)
+		{
+			extents[row] = std::abs(m_transformMatrix(row, 0)) * m_halfSizes.getX()
+				+ std::abs(m_transformMatrix(row, 1)) * m_halfSizes.getY()
+				+ std::abs(m_transformMatrix(row, 2)) * m_halfSizes.getZ();
+		}
 
-		return vertices;
+		return BoundingBox {
+			m_transformMatrix(0, 3) - extents[0], m_transformMatrix(1, 3) - extents[1], m_transformMatrix(2, 3) - extents[2],
+			2 * extents[0], 2 * extents[1], 2 * extents[2]
+		};
 	}
-}
\ No newline at end of file
+}
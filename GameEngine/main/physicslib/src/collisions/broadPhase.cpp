@@ -0,0 +1,35 @@
+#include "collisions/broadPhase.hpp"
+
+#include "collisions/boxPrimitive.hpp"
+#include "collisions/dynamicAabbTree.hpp"
+#include "collisions/linearOctree.hpp"
+#include "collisions/octreeBroadPhase.hpp"
+#include "collisions/sweepAndPrune.hpp"
+
+namespace physicslib
+{
+	void BroadPhase::update(const RigidBodyWorld& world, WorkerPool& /*workerPool*/)
+	{
+		update(world);
+	}
+
+	BoundingBox BroadPhase::getBoundingBox(const RigidBodyWorld& world, std::size_t index)
+	{
+		return BoxPrimitive(world.getWorldTransformMatrix(index), world.getBoxSize(index)).getBoundingBox();
+	}
+
+	std::unique_ptr<BroadPhase> createBroadPhase(BroadPhaseType type, const BoundingBox& bounds)
+	{
+		switch (type)
+		{
+		case BroadPhaseType::LINEAR_OCTREE:
+			return std::make_unique<LinearOctree>(bounds);
+		case BroadPhaseType::DYNAMIC_AABB_TREE:
+			return std::make_unique<DynamicAabbTree>();
+		case BroadPhaseType::SWEEP_AND_PRUNE:
+			return std::make_unique<SweepAndPrune>();
+		default:
+			return std::make_unique<OctreeBroadPhase>(bounds);
+		}
+	}
+}
@@ -2,7 +2,7 @@
 
 namespace physicslib
 {
-	Contact::Contact(const Vector3& contactPoint, const Vector3& contactNormal, double penetration)
+	Contact::Contact(const Vector3& contactPoint, const Vector3& contactNormal, real penetration)
 		: m_contactPoint(contactPoint)
 		, m_contactNormal(contactNormal)
 		, m_penetration(penetration)
@@ -11,10 +11,10 @@ namespace physicslib
 
 	void ContactRegister::clear()
 	{
-		m_register = std::vector<ParticleContact>();
+		m_register.clear();
 	}
 	
-	void ContactRegister::resolveContacts(double frametime)
+	void ContactRegister::resolveContacts(real frametime)
 	{
 		auto contact = std::begin(m_register);
 		while (contact != std::end(m_register))
@@ -0,0 +1,402 @@
+#include "collisions/dynamicAabbTree.hpp"
+
+#include <limits>
+
+namespace physicslib
+{
+	DynamicAabbTree::DynamicAabbTree(real margin)
+		: m_margin(margin)
+	{
+	}
+
+	void DynamicAabbTree::update(const RigidBodyWorld& world)
+	{
+		// The leaves of the removed bodies leave the tree
+		for (std::uint32_t& leaf : m_bodyLeaves)
+		{
+			if (leaf != INVALID_NODE && !world.isValid(m_nodes[leaf].body))
+			{
+				removeLeaf(leaf);
+				freeNode(leaf);
+				--m_leafCount;
+				leaf = INVALID_NODE;
+			}
+		}
+
+		// The new bodies get a leaf, a sleeping body does not move so its leaf is up to date
+		for (std::size_t i = 0; i < world.getSize(); ++i)
+		{
+			const RigidBodyHandle handle = world.getHandle(i);
+			if (handle.slot >= m_bodyLeaves.size())
+			{
+				m_bodyLeaves.resize(handle.slot + 1, INVALID_NODE);
+			}
+
+			std::uint32_t& leaf = m_bodyLeaves[handle.slot];
+			if (leaf == INVALID_NODE)
+			{
+				leaf = insertLeaf(getBoundingBox(world, i), handle);
+			}
+			else if (world.isAwake(i))
+			{
+				// The leaf only moves in the tree when the body leaves its fat bounds
+				const BoundingBox bodyBounds = getBoundingBox(world, i);
+				m_nodes[leaf].bodyBounds = bodyBounds;
+				if (!m_nodes[leaf].bounds.contains(bodyBounds))
+				{
+					removeLeaf(leaf);
+					m_nodes[leaf].bounds = getFatBounds(bodyBounds);
+					insertLeaf(leaf);
+				}
+			}
+		}
+	}
+
+	void DynamicAabbTree::query(const BoundingBox& bounds, std::vector<RigidBodyHandle>& result) const
+	{
+		if (m_root == INVALID_NODE)
+		{
+			return;
+		}
+
+		m_stack.clear();
+		m_stack.push_back(m_root);
+		while (!m_stack.empty())
+		{
+			const Node& node = m_nodes[m_stack.back()];
+			m_stack.pop_back();
+			if (!node.bounds.overlaps(bounds))
+			{
+				continue;
+			}
+
+			if (node.isLeaf())
+			{
+				if (node.bodyBounds.overlaps(bounds))
+				{
+					result.push_back(node.body);
+				}
+			}
+			else
+			{
+				m_stack.push_back(node.children[0]);
+				m_stack.push_back(node.children[1]);
+			}
+		}
+	}
+
+	void DynamicAabbTree::getOverlappingPairs(std::vector<std::pair<RigidBodyHandle, RigidBodyHandle>>& pairs) const
+	{
+		if (m_root == INVALID_NODE)
+		{
+			return;
+		}
+
+		// A pair of nodes stands for the pairs of leaves taken one in each subtree, a node paired with itself for
+		// the pairs of leaves of its subtree: as the subtrees of the children are disjoint, each pair is visited once
+		m_pairStack.clear();
+		m_pairStack.push_back(std::make_pair(m_root, m_root));
+		while (!m_pairStack.empty())
+		{
+			const std::pair<std::uint32_t, std::uint32_t> nodePair = m_pairStack.back();
+			m_pairStack.pop_back();
+			const Node& first = m_nodes[nodePair.first];
+			const Node& second = m_nodes[nodePair.second];
+
+			if (nodePair.first == nodePair.second)
+			{
+				if (!first.isLeaf())
+				{
+					m_pairStack.push_back(std::make_pair(first.children[0], first.children[0]));
+					m_pairStack.push_back(std::make_pair(first.children[1], first.children[1]));
+					m_pairStack.push_back(std::make_pair(first.children[0], first.children[1]));
+				}
+			}
+			else if (first.bounds.overlaps(second.bounds))
+			{
+				if (first.isLeaf() && second.isLeaf())
+				{
+					if (first.bodyBounds.overlaps(second.bodyBounds))
+					{
+						pairs.push_back(std::make_pair(first.body, second.body));
+					}
+				}
+				else if (second.isLeaf() || (!first.isLeaf() && first.bounds.getSurfaceArea() >= second.bounds.getSurfaceArea()))
+				{
+					// The larger node is split first, it prunes more
+					m_pairStack.push_back(std::make_pair(first.children[0], nodePair.second));
+					m_pairStack.push_back(std::make_pair(first.children[1], nodePair.second));
+				}
+				else
+				{
+					m_pairStack.push_back(std::make_pair(nodePair.first, second.children[0]));
+					m_pairStack.push_back(std::make_pair(nodePair.first, second.children[1]));
+				}
+			}
+		}
+	}
+
+	std::size_t DynamicAabbTree::getLeafCount() const
+	{
+		return m_leafCount;
+	}
+
+	std::size_t DynamicAabbTree::getHeight() const
+	{
+		std::size_t height = 0;
+		for (std::uint32_t leaf : m_bodyLeaves)
+		{
+			if (leaf != INVALID_NODE)
+			{
+				std::size_t depth = 1;
+				for (std::uint32_t node = m_nodes[leaf].parent; node != INVALID_NODE; node = m_nodes[node].parent)
+				{
+					++depth;
+				}
+				height = std::max(height, depth);
+			}
+		}
+
+		return height;
+	}
+
+	real DynamicAabbTree::getSurfaceAreaCost() const
+	{
+		real cost = 0;
+		if (m_root == INVALID_NODE)
+		{
+			return cost;
+		}
+
+		m_stack.clear();
+		m_stack.push_back(m_root);
+		while (!m_stack.empty())
+		{
+			const Node& node = m_nodes[m_stack.back()];
+			m_stack.pop_back();
+			if (!node.isLeaf())
+			{
+				cost += node.bounds.getSurfaceArea();
+				m_stack.push_back(node.children[0]);
+				m_stack.push_back(node.children[1]);
+			}
+		}
+
+		return cost;
+	}
+
+	std::uint32_t DynamicAabbTree::allocateNode()
+	{
+		std::uint32_t node = m_freeNode;
+		if (node != INVALID_NODE)
+		{
+			m_freeNode = m_nodes[node].parent;
+		}
+		else
+		{
+			node = static_cast<std::uint32_t>(m_nodes.size());
+			m_nodes.emplace_back();
+		}
+
+		m_nodes[node].parent = INVALID_NODE;
+		m_nodes[node].children[0] = INVALID_NODE;
+		m_nodes[node].children[1] = INVALID_NODE;
+		m_nodes[node].body = RigidBodyHandle();
+		return node;
+	}
+
+	void DynamicAabbTree::freeNode(std::uint32_t node)
+	{
+		m_nodes[node].parent = m_freeNode;
+		m_freeNode = node;
+	}
+
+	BoundingBox DynamicAabbTree::getFatBounds(const BoundingBox& bodyBounds) const
+	{
+		return BoundingBox {
+			bodyBounds.x - m_margin, bodyBounds.y - m_margin, bodyBounds.z - m_margin,
+			bodyBounds.width + 2 * m_margin, bodyBounds.height + 2 * m_margin, bodyBounds.depth + 2 * m_margin
+		};
+	}
+
+	std::uint32_t DynamicAabbTree::insertLeaf(const BoundingBox& bodyBounds, RigidBodyHandle body)
+	{
+		const std::uint32_t leaf = allocateNode();
+		m_nodes[leaf].bounds = getFatBounds(bodyBounds);
+		m_nodes[leaf].bodyBounds = bodyBounds;
+		m_nodes[leaf].body = body;
+		insertLeaf(leaf);
+		++m_leafCount;
+
+		return leaf;
+	}
+
+	void DynamicAabbTree::insertLeaf(std::uint32_t leaf)
+	{
+		if (m_root == INVALID_NODE)
+		{
+			m_root = leaf;
+			m_nodes[leaf].parent = INVALID_NODE;
+			return;
+		}
+
+		// The leaf and its sibling become the children of a new inner node, in place of the sibling
+		const std::uint32_t sibling = findBestSibling(m_nodes[leaf].bounds);
+		const std::uint32_t oldParent = m_nodes[sibling].parent;
+		const std::uint32_t newParent = allocateNode();
+		m_nodes[newParent].parent = oldParent;
+		m_nodes[newParent].children[0] = sibling;
+		m_nodes[newParent].children[1] = leaf;
+		if (oldParent == INVALID_NODE)
+		{
+			m_root = newParent;
+		}
+		else
+		{
+			replaceChild(oldParent, sibling, newParent);
+		}
+		m_nodes[sibling].parent = newParent;
+		m_nodes[leaf].parent = newParent;
+
+		refit(newParent, true);
+	}
+
+	void DynamicAabbTree::removeLeaf(std::uint32_t leaf)
+	{
+		if (leaf == m_root)
+		{
+			m_root = INVALID_NODE;
+			return;
+		}
+
+		// The sibling of the leaf takes the place of their parent
+		const std::uint32_t parent = m_nodes[leaf].parent;
+		const std::uint32_t grandParent = m_nodes[parent].parent;
+		const std::uint32_t sibling = m_nodes[parent].children[(m_nodes[parent].children[0] == leaf) ? 1 : 0];
+		m_nodes[sibling].parent = grandParent;
+		if (grandParent == INVALID_NODE)
+		{
+			m_root = sibling;
+		}
+		else
+		{
+			replaceChild(grandParent, parent, sibling);
+			refit(grandParent, false);
+		}
+
+		freeNode(parent);
+	}
+
+	std::uint32_t DynamicAabbTree::findBestSibling(const BoundingBox& bounds) const
+	{
+		// Choosing a sibling costs the area of the new parent and the growth of the ancestors of the sibling.
+		// Descending in a child costs at least the area of the leaf and the growth of the child and of its ancestors:
+		// the descent follows the child with the lowest bound, and stops when no child can beat the best sibling.
+		const real leafArea = bounds.getSurfaceArea();
+		std::uint32_t bestSibling = m_root;
+		real bestCost = bounds.merge(m_nodes[m_root].bounds).getSurfaceArea();
+		real inheritedCost = 0;
+		std::uint32_t node = m_root;
+		while (!m_nodes[node].isLeaf())
+		{
+			const real directCost = bounds.merge(m_nodes[node].bounds).getSurfaceArea();
+			if (directCost + inheritedCost < bestCost)
+			{
+				bestSibling = node;
+				bestCost = directCost + inheritedCost;
+			}
+			inheritedCost += directCost - m_nodes[node].bounds.getSurfaceArea();
+
+			real lowerCosts[2];
+			for (int i = 0; i < 2; ++i)
+			{
+				const Node& child = m_nodes[m_nodes[node].children[i]];
+				const real childDirectCost = bounds.merge(child.bounds).getSurfaceArea();
+				if (child.isLeaf())
+				{
+					// A leaf cannot be descended in, it is only a candidate sibling
+					if (childDirectCost + inheritedCost < bestCost)
+					{
+						bestSibling = m_nodes[node].children[i];
+						bestCost = childDirectCost + inheritedCost;
+					}
+					lowerCosts[i] = std::numeric_limits<real>::max();
+				}
+				else
+				{
+					lowerCosts[i] = inheritedCost + childDirectCost - child.bounds.getSurfaceArea() + leafArea;
+				}
+			}
+
+			if (lowerCosts[0] >= bestCost && lowerCosts[1] >= bestCost)
+			{
+				break;
+			}
+			node = m_nodes[node].children[(lowerCosts[0] <= lowerCosts[1]) ? 0 : 1];
+		}
+
+		return bestSibling;
+	}
+
+	void DynamicAabbTree::refit(std::uint32_t node, bool rotate)
+	{
+		for (; node != INVALID_NODE; node = m_nodes[node].parent)
+		{
+			Node& innerNode = m_nodes[node];
+			innerNode.bounds = m_nodes[innerNode.children[0]].bounds.merge(m_nodes[innerNode.children[1]].bounds);
+			if (rotate)
+			{
+				this->rotate(node);
+			}
+		}
+	}
+
+	void DynamicAabbTree::rotate(std::uint32_t node)
+	{
+		// Swapping the child i of the node with the child j of its other child keeps the bounds of the node,
+		// only the bounds of the other child change: the best swap is the one which shrinks them most
+		int bestChild = -1;
+		int bestGrandchild = -1;
+		real bestAreaChange = 0;
+		for (int i = 0; i < 2; ++i)
+		{
+			const Node& child = m_nodes[m_nodes[node].children[i]];
+			const Node& otherChild = m_nodes[m_nodes[node].children[1 - i]];
+			if (otherChild.isLeaf())
+			{
+				continue;
+			}
+
+			const real otherChildArea = otherChild.bounds.getSurfaceArea();
+			for (int j = 0; j < 2; ++j)
+			{
+				const real areaChange = child.bounds.merge(m_nodes[otherChild.children[1 - j]].bounds).getSurfaceArea() - otherChildArea;
+				if (areaChange < bestAreaChange)
+				{
+					bestChild = i;
+					bestGrandchild = j;
+					bestAreaChange = areaChange;
+				}
+			}
+		}
+
+		if (bestChild < 0)
+		{
+			return;
+		}
+
+		const std::uint32_t child = m_nodes[node].children[bestChild];
+		const std::uint32_t otherChild = m_nodes[node].children[1 - bestChild];
+		const std::uint32_t grandchild = m_nodes[otherChild].children[bestGrandchild];
+		m_nodes[node].children[bestChild] = grandchild;
+		m_nodes[grandchild].parent = node;
+		m_nodes[otherChild].children[bestGrandchild] = child;
+		m_nodes[child].parent = otherChild;
+		m_nodes[otherChild].bounds = m_nodes[m_nodes[otherChild].children[0]].bounds.merge(m_nodes[m_nodes[otherChild].children[1]].bounds);
+	}
+
+	void DynamicAabbTree::replaceChild(std::uint32_t parent, std::uint32_t child, std::uint32_t newChild)
+	{
+		m_nodes[parent].children[(m_nodes[parent].children[0] == child) ? 0 : 1] = newChild;
+	}
+}
@@ -0,0 +1,291 @@
+#include "collisions/linearOctree.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace physicslib
+{
+	namespace
+	{
+		/**
+		 * Call `function(begin, end)` on chunks covering [0, count[, on `workerPool` if it is not null
+		 */
+		template <typename Function>
+		void parallelFor(WorkerPool* workerPool, std::size_t count, std::size_t chunkSize, const Function& function)
+		{
+			if (workerPool != nullptr)
+			{
+				workerPool->parallelFor(count, chunkSize, function);
+			}
+			else
+			{
+				function(0, count);
+			}
+		}
+
+		/**
+		 * Insert two zero bits between each of the 10 low bits of `value`
+		 */
+		std::uint32_t expandBits(std::uint32_t value)
+		{
+			value = (value * 0x00010001u) & 0xFF0000FFu;
+			value = (value * 0x00000101u) & 0x0F00F00Fu;
+			value = (value * 0x00000011u) & 0xC30C30C3u;
+			value = (value * 0x00000005u) & 0x49249249u;
+			return value;
+		}
+	}
+
+	LinearOctree::LinearOctree(const BoundingBox& bounds, std::size_t maxBodiesByLeaf)
+		: m_bounds(bounds)
+		, m_maxBodiesByLeaf(std::max<std::size_t>(maxBodiesByLeaf, 1))
+	{
+	}
+
+	void LinearOctree::update(const RigidBodyWorld& world)
+	{
+		build(world, nullptr);
+	}
+
+	void LinearOctree::update(const RigidBodyWorld& world, WorkerPool& workerPool)
+	{
+		build(world, &workerPool);
+	}
+
+	std::uint32_t LinearOctree::getMortonCode(std::uint32_t x, std::uint32_t y, std::uint32_t z)
+	{
+		return (expandBits(x) << 2) | (expandBits(y) << 1) | expandBits(z);
+	}
+
+	void LinearOctree::build(const RigidBodyWorld& world, WorkerPool* workerPool)
+	{
+		const std::size_t bodyCount = world.getSize();
+		m_bodyBounds.resize(bodyCount);
+		m_codes.resize(bodyCount);
+		m_indices.resize(bodyCount);
+
+		// Morton code of the cell of the center of each body
+		const real cellCount = real(1u << MORTON_BITS_BY_AXIS);
+		const Vector3 scale(cellCount / m_bounds.width, cellCount / m_bounds.height, cellCount / m_bounds.depth);
+		parallelFor(workerPool, bodyCount, CHUNK_SIZE, [this, &world, cellCount, scale](std::size_t begin, std::size_t end)
+		{
+			const auto getCell = [cellCount](real coordinate)
+			{
+				return std::uint32_t(std::min(std::max(std::floor(coordinate), real(0)), cellCount - 1));
+			};
+
+			for (std::size_t i = begin; i < end; ++i)
+			{
+				const BoundingBox bounds = getBoundingBox(world, i);
+				m_bodyBounds[i] = bounds;
+				m_codes[i] = getMortonCode(
+					getCell((bounds.x + bounds.width / 2 - m_bounds.x) * scale.getX()),
+					getCell((bounds.y + bounds.height / 2 - m_bounds.y) * scale.getY()),
+					getCell((bounds.z + bounds.depth / 2 - m_bounds.z) * scale.getZ()));
+				m_indices[i] = std::uint32_t(i);
+			}
+		});
+
+		sort(workerPool != nullptr ? workerPool->getThreadCount() : 1, workerPool);
+
+		// The bodies in the order of the codes, so that the nodes read contiguous bounds
+		m_sortedBounds.resize(bodyCount);
+		m_sortedBodies.resize(bodyCount);
+		parallelFor(workerPool, bodyCount, CHUNK_SIZE, [this, &world](std::size_t begin, std::size_t end)
+		{
+			for (std::size_t i = begin; i < end; ++i)
+			{
+				m_sortedBounds[i] = m_bodyBounds[m_indices[i]];
+				m_sortedBodies[i] = world.getHandle(m_indices[i]);
+			}
+		});
+
+		// The nodes are cut level by level: the bodies of a child share the 3 bits of its octant at the level of its parent
+		m_nodes.clear();
+		if (bodyCount == 0)
+		{
+			return;
+		}
+		m_nodes.push_back(Node { BoundingBox {}, 0, std::uint32_t(bodyCount), 0, 0 });
+		std::size_t levelBegin = 0;
+		for (unsigned int level = 0; level < MORTON_BITS_BY_AXIS && levelBegin < m_nodes.size(); ++level)
+		{
+			const std::size_t levelEnd = m_nodes.size();
+			const std::uint32_t shift = 3 * (MORTON_BITS_BY_AXIS - 1 - level);
+			for (std::size_t node = levelBegin; node < levelEnd; ++node)
+			{
+				const std::uint32_t nodeBegin = m_nodes[node].begin;
+				const std::uint32_t nodeEnd = m_nodes[node].end;
+				if (nodeEnd - nodeBegin <= m_maxBodiesByLeaf)
+				{
+					continue;
+				}
+
+				m_nodes[node].firstChild = std::uint32_t(m_nodes.size());
+				for (std::uint32_t begin = nodeBegin; begin < nodeEnd;)
+				{
+					const std::uint32_t octant = (m_codes[begin] >> shift) & 7;
+					const std::uint32_t end = std::uint32_t(std::upper_bound(m_codes.begin() + begin, m_codes.begin() + nodeEnd, octant,
+						[shift](std::uint32_t value, std::uint32_t code)
+						{
+							return value < ((code >> shift) & 7);
+						}) - m_codes.begin());
+					m_nodes.push_back(Node { BoundingBox {}, begin, end, 0, 0 });
+					++m_nodes[node].childCount;
+					begin = end;
+				}
+			}
+			levelBegin = levelEnd;
+		}
+
+		// Bounds of the leaves, then of their parents which come before them
+		parallelFor(workerPool, m_nodes.size(), CHUNK_SIZE / m_maxBodiesByLeaf + 1, [this](std::size_t begin, std::size_t end)
+		{
+			for (std::size_t node = begin; node < end; ++node)
+			{
+				if (m_nodes[node].childCount == 0)
+				{
+					BoundingBox bounds = m_sortedBounds[m_nodes[node].begin];
+					for (std::uint32_t i = m_nodes[node].begin + 1; i < m_nodes[node].end; ++i)
+					{
+						bounds = bounds.merge(m_sortedBounds[i]);
+					}
+					m_nodes[node].bounds = bounds;
+				}
+			}
+		});
+		for (std::size_t node = m_nodes.size(); node-- > 0;)
+		{
+			if (m_nodes[node].childCount != 0)
+			{
+				BoundingBox bounds = m_nodes[m_nodes[node].firstChild].bounds;
+				for (std::uint32_t child = 1; child < m_nodes[node].childCount; ++child)
+				{
+					bounds = bounds.merge(m_nodes[m_nodes[node].firstChild + child].bounds);
+				}
+				m_nodes[node].bounds = bounds;
+			}
+		}
+	}
+
+	void LinearOctree::sort(std::size_t partitionCount, WorkerPool* workerPool)
+	{
+		// Least significant digit first radix sort, each pass is stable
+		const std::size_t count = m_codes.size();
+		m_sortCodes.resize(count);
+		m_sortIndices.resize(count);
+		m_histograms.resize(partitionCount * RADIX_SIZE);
+		for (std::uint32_t shift = 0; shift < 3 * MORTON_BITS_BY_AXIS; shift += RADIX_BITS)
+		{
+			// Count the digits of each partition
+			parallelFor(workerPool, partitionCount, 1, [this, count, partitionCount, shift](std::size_t begin, std::size_t end)
+			{
+				for (std::size_t p = begin; p < end; ++p)
+				{
+					std::uint32_t* counters = &m_histograms[p * RADIX_SIZE];
+					std::fill(counters, counters + RADIX_SIZE, 0);
+					for (std::size_t i = count * p / partitionCount; i < count * (p + 1) / partitionCount; ++i)
+					{
+						++counters[(m_codes[i] >> shift) & (RADIX_SIZE - 1)];
+					}
+				}
+			});
+
+			// A partition writes its keys of a digit after the keys of the same digit of the previous partitions
+			std::uint32_t offset = 0;
+			for (std::uint32_t digit = 0; digit < RADIX_SIZE; ++digit)
+			{
+				for (std::size_t p = 0; p < partitionCount; ++p)
+				{
+					const std::uint32_t digitCount = m_histograms[p * RADIX_SIZE + digit];
+					m_histograms[p * RADIX_SIZE + digit] = offset;
+					offset += digitCount;
+				}
+			}
+
+			parallelFor(workerPool, partitionCount, 1, [this, count, partitionCount, shift](std::size_t begin, std::size_t end)
+			{
+				for (std::size_t p = begin; p < end; ++p)
+				{
+					std::uint32_t* offsets = &m_histograms[p * RADIX_SIZE];
+					for (std::size_t i = count * p / partitionCount; i < count * (p + 1) / partitionCount; ++i)
+					{
+						const std::uint32_t position = offsets[(m_codes[i] >> shift) & (RADIX_SIZE - 1)]++;
+						m_sortCodes[position] = m_codes[i];
+						m_sortIndices[position] = m_indices[i];
+					}
+				}
+			});
+
+			m_codes.swap(m_sortCodes);
+			m_indices.swap(m_sortIndices);
+		}
+	}
+
+	template <typename Function>
+	void LinearOctree::visit(const BoundingBox& bounds, const Function& function) const
+	{
+		if (m_nodes.empty())
+		{
+			return;
+		}
+
+		m_stack.clear();
+		m_stack.push_back(0);
+		while (!m_stack.empty())
+		{
+			const Node& node = m_nodes[m_stack.back()];
+			m_stack.pop_back();
+			if (!node.bounds.overlaps(bounds))
+			{
+				continue;
+			}
+
+			if (node.childCount == 0)
+			{
+				for (std::uint32_t i = node.begin; i < node.end; ++i)
+				{
+					if (m_sortedBounds[i].overlaps(bounds))
+					{
+						function(i);
+					}
+				}
+			}
+			else
+			{
+				for (std::uint32_t child = 0; child < node.childCount; ++child)
+				{
+					m_stack.push_back(node.firstChild + child);
+				}
+			}
+		}
+	}
+
+	void LinearOctree::query(const BoundingBox& bounds, std::vector<RigidBodyHandle>& result) const
+	{
+		visit(bounds, [this, &result](std::uint32_t i)
+		{
+			result.push_back(m_sortedBodies[i]);
+		});
+	}
+
+	void LinearOctree::getOverlappingPairs(std::vector<std::pair<RigidBodyHandle, RigidBodyHandle>>& pairs) const
+	{
+		// Each body queries the tree and keeps the bodies after it in the sorted order, so that each pair is found once
+		for (std::uint32_t i = 0; i < m_sortedBounds.size(); ++i)
+		{
+			visit(m_sortedBounds[i], [this, &pairs, i](std::uint32_t j)
+			{
+				if (j > i)
+				{
+					pairs.push_back(std::make_pair(m_sortedBodies[i], m_sortedBodies[j]));
+				}
+			});
+		}
+	}
+
+	std::size_t LinearOctree::getNodeCount() const
+	{
+		return m_nodes.size();
+	}
+}
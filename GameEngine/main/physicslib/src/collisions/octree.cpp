@@ -9,101 +9,268 @@ namespace physicslib
 	const PlanePrimitive* Octree::m_topPlane = nullptr;
 	const PlanePrimitive* Octree::m_bottomPlane = nullptr;
 
-	Octree::Octree(const unsigned int pLevel, const BoundingBox& pBounds): m_level(pLevel), m_bounds(pBounds)
+	Octree::Octree(const unsigned int pLevel, const BoundingBox& pBounds, const OctreeConfiguration& configuration)
+		: m_configuration(configuration)
 	{
+		m_nodes.push_back(Node { pBounds, getLooseBounds(pBounds), pLevel, INVALID_NODE, INVALID_NODE, 0, {} });
 	}
 
 	void Octree::clear()
 	{
-		m_points.clear();
+		// The vectors of entries of the nodes keep their memory
+		for (Node& node : m_nodes)
+		{
+			node.entries.clear();
+		}
+		m_nodes.front().firstChild = INVALID_NODE;
+		m_nodes.front().subtreeSize = 0;
+		m_freeChildren.clear();
+		for (std::uint32_t firstChild = 1; firstChild < m_nodes.size(); firstChild += 8)
+		{
+			m_freeChildren.push_back(firstChild);
+		}
+
+		m_entries.clear();
+		m_freeEntries.clear();
+		m_size = 0;
+	}
+
+	Octree::Handle Octree::insert(const BoundingBox& bounds, RigidBodyHandle body)
+	{
+		Handle handle;
+		if (!m_freeEntries.empty())
+		{
+			handle = m_freeEntries.back();
+			m_freeEntries.pop_back();
+		}
+		else
+		{
+			handle = Handle(m_entries.size());
+			m_entries.emplace_back();
+		}
+		m_entries[handle].bounds = bounds;
+		m_entries[handle].body = body;
+		++m_size;
+
+		insert(0, handle);
+		return handle;
+	}
+
+	void Octree::update(Handle handle, const BoundingBox& newBounds)
+	{
+		const std::uint32_t node = m_entries[handle].node;
+		m_entries[handle].bounds = newBounds;
+
+		// The entry stays in its node while it is inside its loose bounds and does not fit in a child, the root keeps the entries which left the octree
+		const bool isInside = m_nodes[node].parent == INVALID_NODE || m_nodes[node].looseBounds.contains(newBounds);
+		if (isInside && (m_nodes[node].firstChild == INVALID_NODE || getChild(node, newBounds) == INVALID_NODE))
+		{
+			return;
+		}
+
+		// Climb to the first node accepting the entry, and insert it again from there: a node whose loose bounds contain
+		// the entry but not its center would keep it, as the entry cannot go down to the children of the node
+		detach(handle);
+		std::uint32_t ancestor = node;
+		while (m_nodes[ancestor].parent != INVALID_NODE && !accepts(ancestor, newBounds))
+		{
+			ancestor = m_nodes[ancestor].parent;
+			--m_nodes[ancestor].subtreeSize;
+		}
+		insert(ancestor, handle);
+
+		collapseFrom(node);
+	}
+
+	void Octree::remove(Handle handle)
+	{
+		const std::uint32_t node = m_entries[handle].node;
+		detach(handle);
+		for (std::uint32_t ancestor = m_nodes[node].parent; ancestor != INVALID_NODE; ancestor = m_nodes[ancestor].parent)
+		{
+			--m_nodes[ancestor].subtreeSize;
+		}
+
+		m_entries[handle].node = INVALID_NODE;
+		m_freeEntries.push_back(handle);
+		--m_size;
+		collapseFrom(node);
+	}
+
+	const BoundingBox& Octree::getBounds(Handle handle) const
+	{
+		return m_entries[handle].bounds;
+	}
+
+	RigidBodyHandle Octree::getBody(Handle handle) const
+	{
+		return m_entries[handle].body;
+	}
+
+	std::size_t Octree::getSize() const
+	{
+		return m_size;
+	}
 
-		std::for_each(m_nodes.begin(), m_nodes.end(),
-			[](Octree& node)
+	void Octree::detach(Handle handle)
+	{
+		// The last entry of the node takes the place of the removed one
+		const Entry& entry = m_entries[handle];
+		Node& node = m_nodes[entry.node];
+		const Handle lastHandle = node.entries.back();
+		node.entries[entry.position] = lastHandle;
+		m_entries[lastHandle].position = entry.position;
+		node.entries.pop_back();
+		--node.subtreeSize;
+	}
+
+	void Octree::insert(std::uint32_t node, Handle handle)
+	{
+		Entry& entry = m_entries[handle];
+		for (;;)
+		{
+			++m_nodes[node].subtreeSize;
+			if (m_nodes[node].firstChild == INVALID_NODE)
 			{
-				node.clear();
-			});
-		m_nodes.clear();
+				break;
+			}
+
+			// An entry straddling the children stays in their parent
+			const std::uint32_t child = getChild(node, entry.bounds);
+			if (child == INVALID_NODE)
+			{
+				break;
+			}
+			node = child;
+		}
+
+		entry.node = node;
+		entry.position = std::uint32_t(m_nodes[node].entries.size());
+		m_nodes[node].entries.push_back(handle);
+
+		// if we have too many entries we split the leaf and insert the entries in the new nodes
+		if (m_nodes[node].firstChild == INVALID_NODE && m_nodes[node].entries.size() > m_configuration.maxEntriesByNode && m_nodes[node].level < m_configuration.maxLevels)
+		{
+			split(node);
+		}
 	}
 
-	void Octree::split()
+	void Octree::collapseFrom(std::uint32_t node)
 	{
-		double subWidth = m_bounds.width / 2;
-		double subHeight = m_bounds.height / 2;
-		double subDepth = m_bounds.depth / 2;
-
-		// We create the different new octrees
-		BoundingBox node;
-		node.x = m_bounds.x;
-		node.y = m_bounds.y;
-		node.z = m_bounds.z;
-		node.width = subWidth;
-		node.height = subHeight;
-		node.depth = subDepth;
-		m_nodes.push_back(Octree(m_level + 1, node));
-
-		node.x = m_bounds.x + subWidth;
-		node.y = m_bounds.y;
-		node.z = m_bounds.z;
-		node.width = subWidth;
-		node.height = subHeight;
-		node.depth = subDepth;
-		m_nodes.push_back(Octree(m_level + 1, node));
-
-		node.x = m_bounds.x;
-		node.y = m_bounds.y + subHeight;
-		node.z = m_bounds.z;
-		node.width = subWidth;
-		node.height = subHeight;
-		node.depth = subDepth;
-		m_nodes.push_back(Octree(m_level + 1, node));
-
-		node.x = m_bounds.x;
-		node.y = m_bounds.y;
-		node.z = m_bounds.z + subDepth;
-		node.width = subWidth;
-		node.height = subHeight;
-		node.depth = subDepth;
-		m_nodes.push_back(Octree(m_level + 1, node));
-
-		node.x = m_bounds.x + subWidth;
-		node.y = m_bounds.y + subHeight;
-		node.z = m_bounds.z;
-		node.width = subWidth;
-		node.height = subHeight;
-		node.depth = subDepth;
-		m_nodes.push_back(Octree(m_level + 1, node));
-
-		node.x = m_bounds.x + subWidth;
-		node.y = m_bounds.y;
-		node.z = m_bounds.z + subDepth;
-		node.width = subWidth;
-		node.height = subHeight;
-		node.depth = subDepth;
-		m_nodes.push_back(Octree(m_level + 1, node));
-
-		node.x = m_bounds.x;
-		node.y = m_bounds.y + subHeight;
-		node.z = m_bounds.z + subDepth;
-		node.width = subWidth;
-		node.height = subHeight;
-		node.depth = subDepth;
-		m_nodes.push_back(Octree(m_level + 1, node));
-
-		node.x = m_bounds.x + subWidth;
-		node.y = m_bounds.y + subHeight;
-		node.z = m_bounds.z + subDepth;
-		node.width = subWidth;
-		node.height = subHeight;
-		node.depth = subDepth;
-		m_nodes.push_back(Octree(m_level + 1, node));
+		// The highest node with too few entries collapses the whole branch at once
+		std::uint32_t collapsedNode = INVALID_NODE;
+		for (std::uint32_t ancestor = node; ancestor != INVALID_NODE; ancestor = m_nodes[ancestor].parent)
+		{
+			if (m_nodes[ancestor].firstChild != INVALID_NODE && m_nodes[ancestor].subtreeSize < m_configuration.minEntriesByNode)
+			{
+				collapsedNode = ancestor;
+			}
+		}
+
+		if (collapsedNode != INVALID_NODE)
+		{
+			collapse(collapsedNode);
+		}
 	}
 
-	int Octree::getIndex(Vector3 point) const
+	void Octree::collapse(std::uint32_t node)
+	{
+		const std::uint32_t firstChild = m_nodes[node].firstChild;
+		if (firstChild == INVALID_NODE)
+		{
+			return;
+		}
+
+		for (std::uint32_t child = firstChild; child < firstChild + 8; ++child)
+		{
+			collapse(child);
+			for (Handle handle : m_nodes[child].entries)
+			{
+				m_entries[handle].node = node;
+				m_entries[handle].position = std::uint32_t(m_nodes[node].entries.size());
+				m_nodes[node].entries.push_back(handle);
+			}
+			m_nodes[child].entries.clear();
+			m_nodes[child].subtreeSize = 0;
+		}
+
+		m_nodes[node].firstChild = INVALID_NODE;
+		m_freeChildren.push_back(firstChild);
+	}
+
+	void Octree::split(std::uint32_t node)
+	{
+		// The groups of children freed by a collapse or a clear are reused
+		std::uint32_t firstChild;
+		if (!m_freeChildren.empty())
+		{
+			firstChild = m_freeChildren.back();
+			m_freeChildren.pop_back();
+		}
+		else
+		{
+			firstChild = std::uint32_t(m_nodes.size());
+			m_nodes.resize(m_nodes.size() + 8);
+		}
+
+		const BoundingBox bounds = m_nodes[node].bounds;
+		real subWidth = bounds.width / 2;
+		real subHeight = bounds.height / 2;
+		real subDepth = bounds.depth / 2;
+
+		// We create the different new octrees, in the order of getIndex()
+		const BoundingBox childBounds[8] {
+			{ bounds.x, bounds.y, bounds.z, subWidth, subHeight, subDepth },
+			{ bounds.x + subWidth, bounds.y, bounds.z, subWidth, subHeight, subDepth },
+			{ bounds.x, bounds.y + subHeight, bounds.z, subWidth, subHeight, subDepth },
+			{ bounds.x, bounds.y, bounds.z + subDepth, subWidth, subHeight, subDepth },
+			{ bounds.x + subWidth, bounds.y + subHeight, bounds.z, subWidth, subHeight, subDepth },
+			{ bounds.x + subWidth, bounds.y, bounds.z + subDepth, subWidth, subHeight, subDepth },
+			{ bounds.x, bounds.y + subHeight, bounds.z + subDepth, subWidth, subHeight, subDepth },
+			{ bounds.x + subWidth, bounds.y + subHeight, bounds.z + subDepth, subWidth, subHeight, subDepth }
+		};
+		for (std::uint32_t i = 0; i < 8; ++i)
+		{
+			Node& child = m_nodes[firstChild + i];
+			child.bounds = childBounds[i];
+			child.looseBounds = getLooseBounds(childBounds[i]);
+			child.level = m_nodes[node].level + 1;
+			child.parent = node;
+			child.firstChild = INVALID_NODE;
+			child.subtreeSize = 0;
+		}
+		m_nodes[node].firstChild = firstChild;
+
+		// The entries which fit in a child move to it, the others stay in the node
+		std::vector<Handle>& entries = m_nodes[node].entries;
+		std::size_t keptCount = 0;
+		for (std::size_t i = 0; i < entries.size(); ++i)
+		{
+			const Handle handle = entries[i];
+			const std::uint32_t child = getChild(node, m_entries[handle].bounds);
+			if (child == INVALID_NODE)
+			{
+				m_entries[handle].position = std::uint32_t(keptCount);
+				entries[keptCount++] = handle;
+			}
+			else
+			{
+				m_entries[handle].node = child;
+				m_entries[handle].position = std::uint32_t(m_nodes[child].entries.size());
+				m_nodes[child].entries.push_back(handle);
+				++m_nodes[child].subtreeSize;
+			}
+		}
+		entries.resize(keptCount);
+	}
+
+	int Octree::getIndex(std::uint32_t node, Vector3 point) const
 	{
 		int index;
-		double verticalMidpoint = m_bounds.x + (m_bounds.width / 2);
-		double horizontalMidpoint = m_bounds.y + (m_bounds.height / 2);
-		double depthMidPoint = m_bounds.z + (m_bounds.depth / 2);
+		const BoundingBox& bounds = m_nodes[node].bounds;
+		real verticalMidpoint = bounds.x + (bounds.width / 2);
+		real horizontalMidpoint = bounds.y + (bounds.height / 2);
+		real depthMidPoint = bounds.z + (bounds.depth / 2);
 
 		// We look on the 3 different axes
 		bool topQuadrant = (point.getY() > horizontalMidpoint);
@@ -147,48 +314,99 @@ namespace physicslib
 		return index;
 	}
 
-	void Octree::insert(std::shared_ptr<Primitive> body)
+	BoundingBox Octree::getLooseBounds(const BoundingBox& bounds) const
 	{
-		std::vector<Vector3> bodyPoints = body->getVertices();
-		std::for_each(bodyPoints.begin(), bodyPoints.end(),
-			[this](Vector3 point)
-			{
-				insert(point);
-			});
+		const real margin = (m_configuration.looseness - 1) / 2;
+		return BoundingBox {
+			bounds.x - bounds.width * margin, bounds.y - bounds.height * margin, bounds.z - bounds.depth * margin,
+			bounds.width * m_configuration.looseness, bounds.height * m_configuration.looseness, bounds.depth * m_configuration.looseness
+		};
 	}
 
-	void Octree::insert(Vector3 point)
+	std::uint32_t Octree::getChild(std::uint32_t node, const BoundingBox& bounds) const
 	{
-		// if we already has nodes we just insert in the good nodes
-		if (hasNodes())
+		// The entry can only go to the child containing its center
+		const Vector3 center(bounds.x + bounds.width / 2, bounds.y + bounds.height / 2, bounds.z + bounds.depth / 2);
+		if (!m_nodes[node].bounds.contains(BoundingBox { center.getX(), center.getY(), center.getZ(), 0, 0, 0 }))
+		{
+			return INVALID_NODE;
+		}
+
+		const std::uint32_t child = m_nodes[node].firstChild + std::uint32_t(getIndex(node, center));
+		return m_nodes[child].looseBounds.contains(bounds) ? child : INVALID_NODE;
+	}
+
+	bool Octree::accepts(std::uint32_t node, const BoundingBox& bounds) const
+	{
+		const BoundingBox center { bounds.x + bounds.width / 2, bounds.y + bounds.height / 2, bounds.z + bounds.depth / 2, 0, 0, 0 };
+		return m_nodes[node].bounds.contains(center) && m_nodes[node].looseBounds.contains(bounds);
+	}
+
+	bool Octree::hasNodes() const
+	{
+		return m_nodes.front().firstChild != INVALID_NODE;
+	}
+
+	void Octree::query(const BoundingBox& bounds, std::vector<Handle>& result) const
+	{
+		query(0, bounds, result);
+	}
+
+	void Octree::query(std::uint32_t node, const BoundingBox& bounds, std::vector<Handle>& result) const
+	{
+		// The entries of a node are inside its loose bounds, except in the root
+		if (node != 0 && !m_nodes[node].looseBounds.overlaps(bounds))
 		{
-			int index = getIndex(point);
-			m_nodes.at(index).insert(point);
 			return;
 		}
 
-		// if we don't we add inside this octree
-		m_points.push_back(point);
-		// if we have too many point we split the tree and insert the points in the new nodes
-		if (m_points.size() > MAX_RIGIDBODY_BY_LEVEL && m_level < MAX_LEVELS)
+		for (Handle handle : m_nodes[node].entries)
+		{
+			if (m_entries[handle].bounds.overlaps(bounds))
+			{
+				result.push_back(handle);
+			}
+		}
+
+		const std::uint32_t firstChild = m_nodes[node].firstChild;
+		if (firstChild != INVALID_NODE)
+		{
+			for (std::uint32_t child = firstChild; child < firstChild + 8; ++child)
+			{
+				query(child, bounds, result);
+			}
+		}
+	}
+
+	void Octree::getOverlappingPairs(std::vector<std::pair<Handle, Handle>>& pairs) const
+	{
+		// The loose bounds of neighbour nodes overlap: an entry can overlap entries anywhere in the tree, so each entry
+		// queries the whole tree, and keeps the pairs with the entries of greater handle so that each pair is found once
+		for (Handle handle = 0; handle < m_entries.size(); ++handle)
 		{
-			split();
-			std::for_each(m_points.begin(), m_points.end(),
-				[this](Vector3 oldPoint)
+			if (m_entries[handle].node == INVALID_NODE)
+			{
+				continue;
+			}
+
+			m_overlappingEntries.clear();
+			query(0, m_entries[handle].bounds, m_overlappingEntries);
+			for (Handle overlappingEntry : m_overlappingEntries)
+			{
+				if (overlappingEntry > handle)
 				{
-					int index = getIndex(oldPoint);
-					m_nodes.at(index).insert(oldPoint);
-				});
-			m_points.clear();
+					pairs.push_back(std::make_pair(handle, overlappingEntry));
+				}
+			}
 		}
 	}
 
-	bool Octree::hasNodes() const
+	void Octree::retrieve(std::vector<std::pair<Handle, const PlanePrimitive *>>& collisions, bool top, bool right, bool bottom, bool left) const
 	{
-		return (m_nodes.size() != 0);
+		retrieve(0, collisions, top, right, bottom, left);
 	}
 
-	void Octree::retrieve(std::vector<std::pair<Vector3, const PlanePrimitive *>>& collisions, bool top, bool right, bool bottom, bool left) const
+	void Octree::retrieve(std::uint32_t node, std::vector<std::pair<Handle, const PlanePrimitive *>>& collisions, bool top, bool right, bool bottom, bool left) const
 	{
 		/* In this function, we pass 4 bool depending of the position of the octree in the space
 		 * For example _________
@@ -199,73 +417,46 @@ namespace physicslib
 		 */
 
 		/*
-		 * If this is a leave, we add the collision with the planes depending on the bool which are still set to true.
+		 * The entries of the node, which may be a leaf or hold entries straddling its children,
+		 * are added with the planes depending on the bool which are still set to true.
 		 */
-		if (!hasNodes())
+		for (Handle handle : m_nodes[node].entries)
 		{
-			for (unsigned int i = 0; i < m_points.size(); ++i)
+			if (top)
 			{
-				if (top)
-				{
-					collisions.push_back(std::make_pair(m_points.at(i), m_topPlane));
-				}
-				if (left)
-				{
-					collisions.push_back(std::make_pair(m_points.at(i), m_leftPlane));
-				}
-				if (bottom)
-				{
-					collisions.push_back(std::make_pair(m_points.at(i), m_bottomPlane));
-				}
-				if (right)
-				{
-					collisions.push_back(std::make_pair(m_points.at(i), m_rightPlane));
-				}
+				collisions.push_back(std::make_pair(handle, m_topPlane));
+			}
+			if (left)
+			{
+				collisions.push_back(std::make_pair(handle, m_leftPlane));
+			}
+			if (bottom)
+			{
+				collisions.push_back(std::make_pair(handle, m_bottomPlane));
+			}
+			if (right)
+			{
+				collisions.push_back(std::make_pair(handle, m_rightPlane));
 			}
 		}
+
 		/*
 		 * If this is a node, we call retrieve on all the child nodes.
 		 * For each node we update the 4 bools.
 		 * For example, if the current node is on the top right and the child node
 		 * on the bottom right. The only plane possible is on the right. 
 		 */
-		else
+		const std::uint32_t firstChild = m_nodes[node].firstChild;
+		if (firstChild != INVALID_NODE)
 		{
-			for (unsigned int i = 0; i < m_nodes.size(); ++i)
-			{
-				if (i == 0)
-				{
-					m_nodes.at(0).retrieve(collisions, false, false, true && bottom, true && left);
-				}
-				if (i == 1)
-				{
-					m_nodes.at(1).retrieve(collisions, false, true && right, true && bottom, false);
-				}
-				if (i == 2)
-				{
-					m_nodes.at(2).retrieve(collisions, true && top, false, false, true && left);
-				}
-				if (i == 3)
-				{
-					m_nodes.at(3).retrieve(collisions, false, false, true && bottom, true && left);
-				}
-				if (i == 4)
-				{
-					m_nodes.at(4).retrieve(collisions, true && top, true && right, false, false);
-				}
-				if (i == 5)
-				{
-					m_nodes.at(5).retrieve(collisions, false, true && right, true && bottom, false);
-				}
-				if (i == 6)
-				{
-					m_nodes.at(6).retrieve(collisions, true && top, false, false, true && left);
-				}
-				if (i == 7)
-				{
-					m_nodes.at(7).retrieve(collisions, true && top, true && right, false, false);
-				}
-			}
+			retrieve(firstChild + 0, collisions, false, false, true && bottom, true && left);
+			retrieve(firstChild + 1, collisions, false, true && right, true && bottom, false);
+			retrieve(firstChild + 2, collisions, true && top, false, false, true && left);
+			retrieve(firstChild + 3, collisions, false, false, true && bottom, true && left);
+			retrieve(firstChild + 4, collisions, true && top, true && right, false, false);
+			retrieve(firstChild + 5, collisions, false, true && right, true && bottom, false);
+			retrieve(firstChild + 6, collisions, true && top, false, false, true && left);
+			retrieve(firstChild + 7, collisions, true && top, true && right, false, false);
 		}
 	}
 
@@ -0,0 +1,67 @@
+#include "collisions/octreeBroadPhase.hpp"
+
+namespace physicslib
+{
+	OctreeBroadPhase::OctreeBroadPhase(const BoundingBox& bounds, const OctreeConfiguration& configuration)
+		: m_octree(0, bounds, configuration)
+	{
+	}
+
+	void OctreeBroadPhase::update(const RigidBodyWorld& world)
+	{
+		// The entries of the removed bodies leave the octree
+		for (Octree::Handle& entry : m_bodyEntries)
+		{
+			if (entry != Octree::INVALID_HANDLE && !world.isValid(m_octree.getBody(entry)))
+			{
+				m_octree.remove(entry);
+				entry = Octree::INVALID_HANDLE;
+			}
+		}
+
+		// The new bodies get an entry, a sleeping body does not move so its entry is up to date
+		for (std::size_t i = 0; i < world.getSize(); ++i)
+		{
+			const RigidBodyHandle handle = world.getHandle(i);
+			if (handle.slot >= m_bodyEntries.size())
+			{
+				m_bodyEntries.resize(handle.slot + 1, Octree::INVALID_HANDLE);
+			}
+
+			Octree::Handle& entry = m_bodyEntries[handle.slot];
+			if (entry == Octree::INVALID_HANDLE)
+			{
+				entry = m_octree.insert(getBoundingBox(world, i), handle);
+			}
+			else if (world.isAwake(i))
+			{
+				m_octree.update(entry, getBoundingBox(world, i));
+			}
+		}
+	}
+
+	void OctreeBroadPhase::query(const BoundingBox& bounds, std::vector<RigidBodyHandle>& result) const
+	{
+		m_entries.clear();
+		m_octree.query(bounds, m_entries);
+		for (Octree::Handle entry : m_entries)
+		{
+			result.push_back(m_octree.getBody(entry));
+		}
+	}
+
+	void OctreeBroadPhase::getOverlappingPairs(std::vector<std::pair<RigidBodyHandle, RigidBodyHandle>>& pairs) const
+	{
+		m_entryPairs.clear();
+		m_octree.getOverlappingPairs(m_entryPairs);
+		for (const std::pair<Octree::Handle, Octree::Handle>& entryPair : m_entryPairs)
+		{
+			pairs.push_back(std::make_pair(m_octree.getBody(entryPair.first), m_octree.getBody(entryPair.second)));
+		}
+	}
+
+	const Octree& OctreeBroadPhase::getOctree() const
+	{
+		return m_octree;
+	}
+}
@@ -4,7 +4,7 @@
 
 namespace physicslib
 {
-	ParticleCable::ParticleCable(Particle* particle1, Particle* particle2, double maxLength, double restitutionCoef) :
+	ParticleCable::ParticleCable(Particle* particle1, Particle* particle2, real maxLength, real restitutionCoef) :
 		ParticleLink(particle1, particle2), m_maxLength(maxLength), m_restitutionCoef(restitutionCoef)
 	{
 	}
@@ -18,7 +18,7 @@ namespace physicslib
 		if (getCurrentLength() >= m_maxLength)
 		{
 			Vector3 contactNormal = -(m_particles[0]->getPosition() - m_particles[1]->getPosition()).getNormalizedVector();
-			double vs = contactNormal* (m_particles[0]->getSpeed() - m_particles[1]->getSpeed());
+			real vs = contactNormal* (m_particles[0]->getSpeed() - m_particles[1]->getSpeed());
 			ParticleContact particleContact(m_particles[0], m_particles[1], m_restitutionCoef, vs, 0., contactNormal);
 			contactRegister.add(particleContact);
 		}
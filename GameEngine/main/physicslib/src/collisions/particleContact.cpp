@@ -1,16 +1,17 @@
 #include "collisions/particleContact.hpp"
 #include <algorithm>
+#include "math/expression.hpp"
 
 namespace physicslib
 {
-	ParticleContact::ParticleContact(Particle* particle1, Particle* particle2, double restitution, double vs, double penetration, Vector3 normal) :
+	ParticleContact::ParticleContact(Particle* particle1, Particle* particle2, real restitution, real vs, real penetration, Vector3 normal) :
 		m_restitution(restitution), m_vs(vs), m_penetration(penetration), m_contactNormal(normal)
 	{
 		m_particles[0] = particle1;
 		m_particles[1] = particle2;
 	}
 
-	void ParticleContact::resolve(double frametime)
+	void ParticleContact::resolve(real frametime)
 	{
 
 		//calculateVariables();
@@ -37,40 +38,43 @@ namespace physicslib
 		{
 			if (m_particles[0]->getInverseMass() != 0)
 			{
-				Vector3 move1 = m_particles[0]->getPosition() + m_contactNormal * m_penetration;
+				Vector3 move1 = m_particles[0]->getPosition() + expression::lazy(m_contactNormal) * m_penetration;
 				m_particles[0]->setPosition(move1);
 			}
 		}
 		else if (m_particles[1]->getInverseMass() == 0 && m_particles[0]->getInverseMass() != 0)
 		{//particle B is unmovable
-			Vector3 move1 = m_particles[0]->getPosition() + m_contactNormal * m_penetration;
+			Vector3 move1 = m_particles[0]->getPosition() + expression::lazy(m_contactNormal) * m_penetration;
 			m_particles[0]->setPosition(move1);
 		}
 		else if (m_particles[0]->getInverseMass() == 0 && m_particles[1]->getInverseMass() != 0)
 		{//particle A is unmovable
-			Vector3 move2 = m_particles[1]->getPosition() - m_contactNormal * m_penetration;
+			Vector3 move2 = m_particles[1]->getPosition() - expression::lazy(m_contactNormal) * m_penetration;
 			m_particles[1]->setPosition(move2);
 		}
 		else if (m_particles[0]->getInverseMass() != 0 && m_particles[1]->getInverseMass() != 0)
 		{
-			Vector3 move1 = m_particles[0]->getPosition() + m_contactNormal * m_penetration * (1 / m_particles[1]->getInverseMass()) / (1 / m_particles[1]->getInverseMass() + 1 / m_particles[0]->getInverseMass());
-			Vector3 move2 = m_particles[1]->getPosition() - m_contactNormal * m_penetration * (1 / m_particles[0]->getInverseMass()) / (1 / m_particles[1]->getInverseMass() + 1 / m_particles[0]->getInverseMass());
+			// Each particle moves in proportion to the mass of the other one, in a single fused pass
+			const real mass1 = 1 / m_particles[0]->getInverseMass();
+			const real mass2 = 1 / m_particles[1]->getInverseMass();
+			Vector3 move1 = m_particles[0]->getPosition() + expression::lazy(m_contactNormal) * m_penetration * (mass2 / (mass1 + mass2));
+			Vector3 move2 = m_particles[1]->getPosition() - expression::lazy(m_contactNormal) * m_penetration * (mass1 / (mass1 + mass2));
 			m_particles[0]->setPosition(move1);
 			m_particles[1]->setPosition(move2);
 		}
 	}
 
 
-	void ParticleContact::resolveVelocity(double frametime)
+	void ParticleContact::resolveVelocity(real frametime)
 	{
 		if (m_particles[0]->getInverseMass() != 0)
 		{
-			Vector3 newVelocity1 = m_particles[0]->getSpeed() - m_contactNormal * m_particles[0]->getInverseMass() * m_vs * m_restitution;
+			Vector3 newVelocity1 = m_particles[0]->getSpeed() - expression::lazy(m_contactNormal) * m_particles[0]->getInverseMass() * m_vs * m_restitution;
 			m_particles[0]->setSpeed(newVelocity1);
 		}
 		if (m_particles[1] != nullptr && m_particles[1]->getInverseMass() != 0)
 		{
-			Vector3 newVelocity2 = m_particles[1]->getSpeed() + m_contactNormal * m_particles[1]->getInverseMass() * m_vs * m_restitution;
+			Vector3 newVelocity2 = m_particles[1]->getSpeed() + expression::lazy(m_contactNormal) * m_particles[1]->getInverseMass() * m_vs * m_restitution;
 			m_particles[1]->setSpeed(newVelocity2);
 		}
 	}
@@ -13,7 +13,7 @@ namespace physicslib
 	{
 	}
 
-	double ParticleLink::getCurrentLength()
+	real ParticleLink::getCurrentLength()
 	{
 		return m_particles[0]->getDistance(*m_particles[1]);
 	}
@@ -4,7 +4,7 @@
 
 namespace physicslib
 {
-	ParticleRod::ParticleRod(Particle* particle1, Particle* particle2, double length) :
+	ParticleRod::ParticleRod(Particle* particle1, Particle* particle2, real length) :
 		ParticleLink(particle1, particle2), m_length(length)
 	{
 	}
@@ -16,7 +16,7 @@ namespace physicslib
 	void ParticleRod::addContact(ContactRegister& contactRegister)
 	{
 		int direction = 0;
-		double currentLength = getCurrentLength();
+		real currentLength = getCurrentLength();
 		if (currentLength > m_length)
 		{
 			direction = -1;
@@ -26,7 +26,7 @@ namespace physicslib
 			direction = 1;
 		}
 		Vector3 contactNormal = (m_particles[0]->getPosition() - m_particles[1]->getPosition()).getNormalizedVector() * direction;
-		double vs = contactNormal * (m_particles[0]->getSpeed() - m_particles[1]->getSpeed());
+		real vs = contactNormal * (m_particles[0]->getSpeed() - m_particles[1]->getSpeed());
 		//contactRegister.add(ParticleContact(m_particles[0], m_particles[1], 1., vs, 0., contactNormal));
 		ParticleContact particleContact(m_particles[0], m_particles[1], 1., vs, 0., contactNormal);
 		contactRegister.add(particleContact);
@@ -2,7 +2,7 @@
 
 namespace physicslib
 {
-	PlanePrimitive::PlanePrimitive(const Vector3& normal, double offset)
+	PlanePrimitive::PlanePrimitive(const Vector3& normal, real offset)
 		: Primitive(nullptr)
 		, m_normal(normal.getNormalizedVector())
 		, m_offset(offset)
@@ -19,7 +19,7 @@ namespace physicslib
 		return m_normal;
 	}
 
-	double PlanePrimitive::getOffset() const
+	real PlanePrimitive::getOffset() const
 	{
 		return m_offset;
 	}
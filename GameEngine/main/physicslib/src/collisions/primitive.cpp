@@ -1,5 +1,7 @@
 #include "collisions/primitive.hpp"
 
+#include <algorithm>
+
 namespace physicslib
 {
 	Primitive::Primitive(std::shared_ptr<RigidBody> rigidBody)
@@ -7,7 +9,23 @@ namespace physicslib
 	{
 		if (rigidBody != nullptr)
 		{
-			m_transformMatrix = rigidBody->getTransformMatrix(), rigidBody->getPosition();
+			m_transformMatrix = rigidBody->getWorldTransformMatrix();
 		}
 	}
+
+	Primitive::Primitive(const Matrix34& transformMatrix)
+		: m_transformMatrix(transformMatrix)
+	{
+	}
+
+	std::size_t Primitive::getVertexCount() const
+	{
+		return getVertices().size();
+	}
+
+	void Primitive::getVertices(Span<Vector3> vertices) const
+	{
+		const std::vector<Vector3> primitiveVertices = getVertices();
+		std::copy(primitiveVertices.begin(), primitiveVertices.end(), vertices.begin());
+	}
 }
\ No newline at end of file
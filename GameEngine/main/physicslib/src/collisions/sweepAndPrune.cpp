@@ -0,0 +1,188 @@
+#include "collisions/sweepAndPrune.hpp"
+
+#include <algorithm>
+
+namespace physicslib
+{
+	void SweepAndPrune::update(const RigidBodyWorld& world)
+	{
+		// The entries of the removed bodies leave the list, which stays sorted
+		const auto removedEntries = std::remove_if(m_entries.begin(), m_entries.end(), [this, &world](const Entry& entry)
+			{
+				if (world.isValid(entry.body))
+				{
+					return false;
+				}
+
+				m_hasEntry[entry.body.slot] = false;
+				return true;
+			});
+		m_entries.erase(removedEntries, m_entries.end());
+
+		// The bounds of the awake bodies are updated in the order of the world, a sleeping body does not move.
+		// The new bodies get an entry at the end of the list.
+		const std::size_t oldEntryCount = m_entries.size();
+		for (std::size_t i = 0; i < world.getSize(); ++i)
+		{
+			const RigidBodyHandle handle = world.getHandle(i);
+			if (handle.slot >= m_hasEntry.size())
+			{
+				m_hasEntry.resize(handle.slot + 1, false);
+				m_bodyBounds.resize(handle.slot + 1);
+			}
+
+			if (!m_hasEntry[handle.slot])
+			{
+				m_hasEntry[handle.slot] = true;
+				m_entries.push_back(Entry { 0, 0, BoundingBox(), handle });
+				m_bodyBounds[handle.slot] = getBoundingBox(world, i);
+			}
+			else if (world.isAwake(i))
+			{
+				m_bodyBounds[handle.slot] = getBoundingBox(world, i);
+			}
+		}
+
+		for (Entry& entry : m_entries)
+		{
+			entry.bounds = m_bodyBounds[entry.body.slot];
+		}
+
+		// The sweep axis is the axis along which the centers spread most
+		real sums[3] = { 0, 0, 0 };
+		real squaredSums[3] = { 0, 0, 0 };
+		for (const Entry& entry : m_entries)
+		{
+			const real centers[3] = {
+				entry.bounds.x + entry.bounds.width / 2,
+				entry.bounds.y + entry.bounds.height / 2,
+				entry.bounds.z + entry.bounds.depth / 2
+			};
+			for (unsigned int axis = 0; axis < 3; ++axis)
+			{
+				sums[axis] += centers[axis];
+				squaredSums[axis] += centers[axis] * centers[axis];
+			}
+		}
+
+		real variances[3];
+		for (unsigned int axis = 0; axis < 3; ++axis)
+		{
+			const real mean = m_entries.empty() ? real(0) : sums[axis] / real(m_entries.size());
+			variances[axis] = m_entries.empty() ? real(0) : squaredSums[axis] / real(m_entries.size()) - mean * mean;
+		}
+
+		const unsigned int largestAxis = static_cast<unsigned int>(std::max_element(variances, variances + 3) - variances);
+		const bool isAxisChanged = variances[largestAxis] > AXIS_SWITCH_RATIO * variances[m_axis];
+		if (isAxisChanged)
+		{
+			m_axis = largestAxis;
+		}
+		updateEndpoints();
+
+		// A nearly sorted list is sorted by insertion, many new entries or a new axis are sorted from scratch
+		const bool isMostlyNew = (m_entries.size() - oldEntryCount) * 8 > m_entries.size();
+		if (isAxisChanged || isMostlyNew || !insertionSort())
+		{
+			std::sort(m_entries.begin(), m_entries.end(), [](const Entry& entry, const Entry& anotherEntry)
+				{
+					return entry.min < anotherEntry.min;
+				});
+		}
+	}
+
+	void SweepAndPrune::query(const BoundingBox& bounds, std::vector<RigidBodyHandle>& result) const
+	{
+		const real queryMax = (m_axis == 0) ? bounds.x + bounds.width : (m_axis == 1) ? bounds.y + bounds.height : bounds.z + bounds.depth;
+		for (const Entry& entry : m_entries)
+		{
+			if (entry.min > queryMax)
+			{
+				break;
+			}
+
+			if (entry.bounds.overlaps(bounds))
+			{
+				result.push_back(entry.body);
+			}
+		}
+	}
+
+	void SweepAndPrune::getOverlappingPairs(std::vector<std::pair<RigidBodyHandle, RigidBodyHandle>>& pairs) const
+	{
+		// The following entries starting before the end of an entry overlap it on the sweep axis
+		for (std::size_t i = 0; i < m_entries.size(); ++i)
+		{
+			const Entry& entry = m_entries[i];
+			for (std::size_t j = i + 1; j < m_entries.size() && m_entries[j].min <= entry.max; ++j)
+			{
+				if (entry.bounds.overlaps(m_entries[j].bounds))
+				{
+					pairs.push_back(std::make_pair(entry.body, m_entries[j].body));
+				}
+			}
+		}
+	}
+
+	unsigned int SweepAndPrune::getAxis() const
+	{
+		return m_axis;
+	}
+
+	void SweepAndPrune::updateEndpoints()
+	{
+		switch (m_axis)
+		{
+		case 0:
+			for (Entry& entry : m_entries)
+			{
+				entry.min = entry.bounds.x;
+				entry.max = entry.bounds.x + entry.bounds.width;
+			}
+			break;
+		case 1:
+			for (Entry& entry : m_entries)
+			{
+				entry.min = entry.bounds.y;
+				entry.max = entry.bounds.y + entry.bounds.height;
+			}
+			break;
+		default:
+			for (Entry& entry : m_entries)
+			{
+				entry.min = entry.bounds.z;
+				entry.max = entry.bounds.z + entry.bounds.depth;
+			}
+			break;
+		}
+	}
+
+	bool SweepAndPrune::insertionSort()
+	{
+		const std::size_t maxMoveCount = MAX_MOVES_BY_ENTRY * m_entries.size();
+		std::size_t moveCount = 0;
+		for (std::size_t i = 1; i < m_entries.size(); ++i)
+		{
+			if (m_entries[i - 1].min <= m_entries[i].min)
+			{
+				continue;
+			}
+
+			const Entry entry = m_entries[i];
+			std::size_t j = i;
+			for (; j > 0 && m_entries[j - 1].min > entry.min; --j)
+			{
+				m_entries[j] = m_entries[j - 1];
+			}
+			m_entries[j] = entry;
+
+			moveCount += i - j;
+			if (moveCount > maxMoveCount)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+}
@@ -0,0 +1,145 @@
+#include "convexHull.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+namespace physicslib
+{
+	namespace
+	{
+		struct Face
+		{
+			std::uint32_t vertices[3];
+			Vector3 normal;
+			real offset; // normal . p for the points p of the plane of the face
+			bool isAlive;
+		};
+
+		/**
+		 * Build the face (a, b, c), turned so that `interiorPoint` is behind it
+		 */
+		Face createFace(Span<const Vector3> points, std::uint32_t a, std::uint32_t b, std::uint32_t c, const Vector3& interiorPoint)
+		{
+			Face face = { { a, b, c }, ((points[b] - points[a]) ^ (points[c] - points[a])).getNormalizedVector(), 0, true };
+			if (face.normal * (interiorPoint - points[a]) > 0)
+			{
+				std::swap(face.vertices[1], face.vertices[2]);
+				face.normal = -face.normal;
+			}
+			face.offset = face.normal * points[a];
+
+			return face;
+		}
+
+		/**
+		 * Get the index of the point farthest from `distance(point)`, and that distance
+		 */
+		template <typename Distance>
+		std::pair<std::uint32_t, real> findFarthest(Span<const Vector3> points, Distance distance)
+		{
+			std::pair<std::uint32_t, real> farthest = { 0, -1 };
+			for (std::uint32_t i = 0; i < points.size(); ++i)
+			{
+				const real pointDistance = distance(points[i]);
+				if (pointDistance > farthest.second)
+				{
+					farthest = { i, pointDistance };
+				}
+			}
+
+			return farthest;
+		}
+	}
+
+	std::vector<std::uint32_t> computeConvexHull(Span<const Vector3> points)
+	{
+		if (points.size() < 4)
+		{
+			return {};
+		}
+
+		// Distances under the tolerance are rounding errors
+		real scale = 0;
+		for (const Vector3& point : points)
+		{
+			scale = std::max({ scale, std::abs(point.getX()), std::abs(point.getY()), std::abs(point.getZ()) });
+		}
+		const real tolerance = 1000 * std::numeric_limits<real>::epsilon() * std::max(scale, real(1));
+
+		// Initial tetrahedron: two far apart points, the farthest from their line, the farthest from their plane
+		const std::uint32_t i0 = findFarthest(points, [](const Vector3& point) { return point.getX(); }).first;
+		const std::uint32_t i1 = findFarthest(points, [&](const Vector3& point) { return (point - points[i0]).getSquaredNorm(); }).first;
+		const Vector3 axis = (points[i1] - points[i0]).getNormalizedVector();
+		const auto third = findFarthest(points, [&](const Vector3& point) { return ((point - points[i0]) ^ axis).getNorm(); });
+		if (third.second <= tolerance)
+		{
+			return {};
+		}
+		const std::uint32_t i2 = third.first;
+		const Vector3 baseNormal = ((points[i1] - points[i0]) ^ (points[i2] - points[i0])).getNormalizedVector();
+		const auto fourth = findFarthest(points, [&](const Vector3& point) { return std::abs(baseNormal * (point - points[i0])); });
+		if (fourth.second <= tolerance)
+		{
+			return {};
+		}
+		const std::uint32_t i3 = fourth.first;
+
+		// The center of the tetrahedron stays inside the hull while it grows
+		const Vector3 interiorPoint = (points[i0] + points[i1] + points[i2] + points[i3]) / 4;
+		std::vector<Face> faces = {
+			createFace(points, i0, i1, i2, interiorPoint),
+			createFace(points, i0, i1, i3, interiorPoint),
+			createFace(points, i0, i2, i3, interiorPoint),
+			createFace(points, i1, i2, i3, interiorPoint)
+		};
+
+		std::vector<std::pair<std::uint32_t, std::uint32_t>> visibleEdges;
+		std::vector<std::pair<std::uint32_t, std::uint32_t>> horizon;
+		for (std::uint32_t i = 0; i < points.size(); ++i)
+		{
+			// The faces which see the point are replaced by a cone from the point to their outline (the horizon)
+			visibleEdges.clear();
+			for (Face& face : faces)
+			{
+				if (face.isAlive && face.normal * points[i] - face.offset > tolerance)
+				{
+					face.isAlive = false;
+					visibleEdges.emplace_back(face.vertices[0], face.vertices[1]);
+					visibleEdges.emplace_back(face.vertices[1], face.vertices[2]);
+					visibleEdges.emplace_back(face.vertices[2], face.vertices[0]);
+				}
+			}
+			if (visibleEdges.empty())
+			{
+				continue;
+			}
+
+			// An edge is on the horizon when the face on its other side is not visible
+			horizon.clear();
+			for (const auto& edge : visibleEdges)
+			{
+				if (std::find(visibleEdges.begin(), visibleEdges.end(), std::make_pair(edge.second, edge.first)) == visibleEdges.end())
+				{
+					horizon.push_back(edge);
+				}
+			}
+
+			faces.erase(std::remove_if(faces.begin(), faces.end(), [](const Face& face) { return !face.isAlive; }), faces.end());
+			for (const auto& edge : horizon)
+			{
+				faces.push_back(createFace(points, edge.first, edge.second, i, interiorPoint));
+			}
+		}
+
+		std::vector<std::uint32_t> indices;
+		indices.reserve(3 * faces.size());
+		for (const Face& face : faces)
+		{
+			indices.insert(indices.end(), face.vertices, face.vertices + 3);
+		}
+
+		return indices;
+	}
+}
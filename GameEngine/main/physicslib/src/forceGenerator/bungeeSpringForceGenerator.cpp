@@ -3,11 +3,11 @@
 namespace physicslib
 {
 	BungeeSpringForceGenerator::BungeeSpringForceGenerator
-	(const std::shared_ptr<const Particle> otherParticle, double elasticity, double restingLength) :
+	(const std::shared_ptr<const Particle> otherParticle, real elasticity, real restingLength) :
 		m_otherParticle(otherParticle), m_elasticity(elasticity), m_restingLength(restingLength)
 	{}
 
-	void BungeeSpringForceGenerator::updateForce(std::shared_ptr<Particle> particle, const double duration) const
+	void BungeeSpringForceGenerator::updateForce(std::shared_ptr<Particle> particle, const real duration) const
 	{
 		Vector3 d = particle->getPosition() - m_otherParticle->getPosition();
 		if (d.getNorm() >= m_restingLength)
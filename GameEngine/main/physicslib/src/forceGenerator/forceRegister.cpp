@@ -1,31 +1,251 @@
 #include "forceGenerator/forceRegister.hpp"
 
 #include <algorithm>
+#include <type_traits>
 
 namespace physicslib
 {
-	ForceRegister::ForceRecord::ForceRecord(const std::shared_ptr<RigidBody> rigidBody,
-		const std::shared_ptr<const RigidBodyForceGenerator> forceGenerator):
+	ForceRegister::ForceRecord::ForceRecord(const RigidBodyHandle rigidBody,
+		ForceGenerator forceGenerator):
 		rigidBody(rigidBody), forceGenerator(forceGenerator)
 	{
 	}
 
 	void ForceRegister::add(const ForceRecord& record)
 	{
-		m_register.push_back(record);
+		auto last = std::find_if(m_register.rbegin(), m_register.rend(),
+			[&record](const ForceRecord& anotherRecord)
+			{
+				return anotherRecord.forceGenerator == record.forceGenerator;
+			});
+		if (last == m_register.rend())
+		{
+			last = std::find_if(m_register.rbegin(), m_register.rend(),
+				[&record](const ForceRecord& anotherRecord)
+				{
+					return anotherRecord.forceGenerator.index() == record.forceGenerator.index();
+				});
+		}
+		m_register.insert(last.base(), record);
+	}
+
+	void ForceRegister::addGlobal(ForceGenerator forceGenerator)
+	{
+		m_globalGenerators.push_back(forceGenerator);
+	}
+
+	void ForceRegister::remove(RigidBodyHandle rigidBody, const RigidBodyForceGenerator* forceGenerator)
+	{
+		// The order of the records is kept, so is the order in which the forces are summed
+		m_register.erase(std::remove_if(m_register.begin(), m_register.end(),
+			[rigidBody, forceGenerator](const ForceRecord& record)
+			{
+				return record.rigidBody == rigidBody && getGenerator(record.forceGenerator) == forceGenerator;
+			}), m_register.end());
+	}
+
+	void ForceRegister::remove(RigidBodyHandle rigidBody)
+	{
+		m_register.erase(std::remove_if(m_register.begin(), m_register.end(),
+			[rigidBody](const ForceRecord& record)
+			{
+				return record.rigidBody == rigidBody;
+			}), m_register.end());
+	}
+
+	void ForceRegister::removeGlobal(const RigidBodyForceGenerator* forceGenerator)
+	{
+		m_globalGenerators.erase(std::remove_if(m_globalGenerators.begin(), m_globalGenerators.end(),
+			[forceGenerator](const ForceGenerator& globalGenerator)
+			{
+				return getGenerator(globalGenerator) == forceGenerator;
+			}), m_globalGenerators.end());
 	}
 
 	void ForceRegister::clear()
 	{
+		m_globalGenerators.clear();
 		m_register.clear();
 	}
 
-	void ForceRegister::updateAllForces(double duration)
+	std::size_t ForceRegister::getSize() const
+	{
+		return m_register.size();
+	}
+
+	void ForceRegister::updateAllForces(RigidBodyWorld& world, real duration)
 	{
-		std::for_each(m_register.begin(), m_register.end(), 
-			[duration](ForceRecord& record)
+		prepare(world);
+
+		const RigidBodyForceState state{ world, world.getForceAccumulators(), world.getTorqueAccumulators() };
+		for (std::size_t p = 0; p < m_partitions.size(); ++p)
+		{
+			applyPartition(p, state, duration);
+		}
+		applyReactions(world);
+	}
+
+	void ForceRegister::updateAllForces(RigidBodyWorld& world, real duration, WorkerPool& workerPool)
+	{
+		prepare(world);
+
+		// The partitions write to the accumulators of disjoint bodies
+		const RigidBodyForceState state{ world, world.getForceAccumulators(), world.getTorqueAccumulators() };
+		workerPool.parallelFor(m_partitions.size(), 1, [this, &state, duration](std::size_t begin, std::size_t end)
+		{
+			for (std::size_t p = begin; p < end; ++p)
 			{
-				record.forceGenerator->updateForce(record.rigidBody, duration);
-			});
+				applyPartition(p, state, duration);
+			}
+		});
+		applyReactions(world);
+	}
+
+	void ForceRegister::prepare(RigidBodyWorld& world)
+	{
+		// The records of the removed bodies are dropped on the way
+		m_register.erase(std::remove_if(m_register.begin(), m_register.end(),
+			[&world](const ForceRecord& record)
+			{
+				return !world.isValid(record.rigidBody);
+			}), m_register.end());
+
+		for (const ForceRecord& record : m_register)
+		{
+			const std::size_t index = world.getIndex(record.rigidBody);
+			if (!world.isAwake(index) && getGenerator(record.forceGenerator)->isWakingUp(world, index))
+			{
+				world.setAwake(index, true);
+			}
+		}
+
+		// The forces would wake the other sleeping bodies up
+		m_awakeIndices.clear();
+		for (std::size_t i = 0; i < world.getSize(); ++i)
+		{
+			if (world.isAwake(i))
+			{
+				m_awakeIndices.push_back(std::uint32_t(i));
+			}
+		}
+
+		// Counting sort of the records of the awake bodies by partition, the order of the register is kept in a partition
+		const std::size_t partitionCount = (world.getSize() + PARTITION_SIZE - 1) / PARTITION_SIZE;
+		m_partitions.resize(partitionCount);
+		m_awakeRecordEnds.assign(partitionCount, 0);
+		std::size_t awakeRecordCount = 0;
+		for (const ForceRecord& record : m_register)
+		{
+			const std::size_t index = world.getIndex(record.rigidBody);
+			if (world.isAwake(index))
+			{
+				++m_awakeRecordEnds[index / PARTITION_SIZE];
+				++awakeRecordCount;
+			}
+		}
+
+		// Each partition is filled from its start, its counter ends at its end
+		std::size_t start = 0;
+		for (std::size_t& end : m_awakeRecordEnds)
+		{
+			const std::size_t count = end;
+			end = start;
+			start += count;
+		}
+
+		m_awakeRecords.resize(awakeRecordCount);
+		for (std::size_t r = 0; r < m_register.size(); ++r)
+		{
+			const std::size_t index = world.getIndex(m_register[r].rigidBody);
+			if (world.isAwake(index))
+			{
+				m_awakeRecords[m_awakeRecordEnds[index / PARTITION_SIZE]++] = AwakeRecord { std::uint32_t(r), std::uint32_t(index) };
+			}
+		}
+	}
+
+	void ForceRegister::applyPartition(std::size_t partition, const RigidBodyForceState& state, real duration)
+	{
+		Partition& buffers = m_partitions[partition];
+		const RigidBodyForceState partitionState{ state.world, state.forceAccumulators, state.torqueAccumulators, &buffers.reactions };
+
+		// The global generators apply to the awake bodies of the partition
+		const std::uint32_t firstIndex = std::uint32_t(partition * PARTITION_SIZE);
+		const auto awakeBegin = std::lower_bound(m_awakeIndices.begin(), m_awakeIndices.end(), firstIndex);
+		const auto awakeEnd = std::lower_bound(awakeBegin, m_awakeIndices.end(), std::uint32_t(firstIndex + PARTITION_SIZE));
+		const Span<const std::uint32_t> awakeIndices = Span<const std::uint32_t>(m_awakeIndices).subspan(awakeBegin - m_awakeIndices.begin(), awakeEnd - awakeBegin);
+		if (!awakeIndices.empty())
+		{
+			for (const ForceGenerator& forceGenerator : m_globalGenerators)
+			{
+				applyBatch(forceGenerator, awakeIndices, partitionState, duration);
+			}
+		}
+
+		// One batch per run of records of the same generator
+		std::size_t begin = (partition == 0) ? 0 : m_awakeRecordEnds[partition - 1];
+		const std::size_t end = m_awakeRecordEnds[partition];
+		while (begin != end)
+		{
+			const ForceGenerator forceGenerator = m_register[m_awakeRecords[begin].record].forceGenerator;
+			buffers.batchIndices.clear();
+			for (; begin != end && m_register[m_awakeRecords[begin].record].forceGenerator == forceGenerator; ++begin)
+			{
+				buffers.batchIndices.push_back(m_awakeRecords[begin].index);
+			}
+
+			applyBatch(forceGenerator, buffers.batchIndices, partitionState, duration);
+		}
+	}
+
+	void ForceRegister::applyReactions(RigidBodyWorld& world)
+	{
+		Span<Vector3> forceAccumulators = world.getForceAccumulators();
+		Span<Vector3> torqueAccumulators = world.getTorqueAccumulators();
+		for (Partition& partition : m_partitions)
+		{
+			for (const ForceReaction& reaction : partition.reactions)
+			{
+				if (reaction.force.getSquaredNorm() == 0 && reaction.torque.getSquaredNorm() == 0)
+				{
+					continue;
+				}
+
+				// The accumulators of a sleeping body are empty, it keeps the force when it wakes up
+				world.setAwake(reaction.index, true);
+				forceAccumulators[reaction.index] += reaction.force;
+				torqueAccumulators[reaction.index] += reaction.torque;
+			}
+			partition.reactions.clear();
+		}
+	}
+
+	const RigidBodyForceGenerator* ForceRegister::getGenerator(const ForceGenerator& forceGenerator)
+	{
+		return std::visit([](const auto* generator) -> const RigidBodyForceGenerator*
+			{
+				return generator;
+			}, forceGenerator);
+	}
+
+	void ForceRegister::applyBatch(const ForceGenerator& forceGenerator, Span<const std::uint32_t> indices, const RigidBodyForceState& state, real duration)
+	{
+		std::visit([indices, &state, duration](const auto* generator)
+			{
+				using Generator = std::remove_const_t<std::remove_pointer_t<decltype(generator)>>;
+				if constexpr (std::is_same_v<Generator, RigidBodyForceGenerator> || std::is_same_v<Generator, RigidBodySpringForceGenerator>)
+				{
+					// The spring computes its other end once per batch, it has no kernel
+					generator->applyBatch(indices, state, duration);
+				}
+				else
+				{
+					const typename Generator::Kernel kernel = generator->getKernel(state, duration);
+					for (std::uint32_t index : indices)
+					{
+						kernel(index);
+					}
+				}
+			}, forceGenerator);
 	}
-}
\ No newline at end of file
+}
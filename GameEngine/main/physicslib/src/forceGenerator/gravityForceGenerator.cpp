@@ -7,7 +7,7 @@ namespace physicslib
 	{
 	}
 
-	void GravityForceGenerator::updateForce(std::shared_ptr<Particle> particle, const double duration) const
+	void GravityForceGenerator::updateForce(std::shared_ptr<Particle> particle, const real duration) const
 	{
 		if (particle->getInverseMass() != 0)
 		{
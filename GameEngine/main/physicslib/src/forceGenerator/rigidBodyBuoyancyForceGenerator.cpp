@@ -0,0 +1,24 @@
+#include "forceGenerator/rigidBodyBuoyancyForceGenerator.hpp"
+
+namespace physicslib
+{
+	RigidBodyBuoyancyForceGenerator::RigidBodyBuoyancyForceGenerator(real liquidHeight, real liquidDensity, Vector3 gravity)
+		: m_liquidHeight(liquidHeight), m_liquidDensity(liquidDensity), m_gravity(gravity)
+	{}
+
+	void RigidBodyBuoyancyForceGenerator::updateForce(std::shared_ptr<RigidBody> rigidBody, const real duration) const
+	{
+		// A RigidBody does not know its shape: its volume is the volume of its bounds
+		const Vector3 boxSize = rigidBody->getBoxSize();
+		rigidBody->addForceAtPoint(getForce(rigidBody->getPosition().getY(), boxSize.getY(), boxSize.getX() * boxSize.getY() * boxSize.getZ()), rigidBody->getPosition());
+	}
+
+	void RigidBodyBuoyancyForceGenerator::applyBatch(Span<const std::uint32_t> indices, const RigidBodyForceState& state, const real duration) const
+	{
+		const Kernel kernel = getKernel(state, duration);
+		for (std::uint32_t index : indices)
+		{
+			kernel(index);
+		}
+	}
+}
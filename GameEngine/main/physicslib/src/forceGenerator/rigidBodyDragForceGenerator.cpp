@@ -2,21 +2,30 @@
 
 namespace physicslib
 {
-	RigidBodyDragForceGenerator::RigidBodyDragForceGenerator(double k1, double k2)
+	RigidBodyDragForceGenerator::RigidBodyDragForceGenerator(real k1, real k2)
 		: m_k1(k1)
 		, m_k2(k2)
 	{
 	}
 
 	/* Add drag forces to the center of the rigidBody */
-	void RigidBodyDragForceGenerator::updateForce(std::shared_ptr<RigidBody> rigidBody, const double duration) const
+	void RigidBodyDragForceGenerator::updateForce(std::shared_ptr<RigidBody> rigidBody, const real duration) const
 	{
-		double speedNorm = rigidBody->getVelocity().getNorm();
-		double squaredSpeedNorm = rigidBody->getVelocity().getSquaredNorm();
+		real speedNorm = rigidBody->getVelocity().getNorm();
+		real squaredSpeedNorm = rigidBody->getVelocity().getSquaredNorm();
 		Vector3 normalizedSpeed = rigidBody->getVelocity().getNormalizedVector();
 
 		Vector3 dragForce = -normalizedSpeed * (m_k1 * speedNorm + m_k2 * squaredSpeedNorm);
 
 		rigidBody->addForceAtPoint(dragForce, rigidBody->getPosition());
 	}
+
+	void RigidBodyDragForceGenerator::applyBatch(Span<const std::uint32_t> indices, const RigidBodyForceState& state, const real duration) const
+	{
+		const Kernel kernel = getKernel(state, duration);
+		for (std::uint32_t index : indices)
+		{
+			kernel(index);
+		}
+	}
 }
\ No newline at end of file
@@ -0,0 +1,17 @@
+#include "forceGenerator/rigidBodyForceGenerator.hpp"
+
+namespace physicslib
+{
+	void RigidBodyForceGenerator::applyBatch(Span<const std::uint32_t> indices, const RigidBodyForceState& state, const real duration) const
+	{
+		for (std::uint32_t index : indices)
+		{
+			// The shared_ptr does not own the copy: no allocation and no reference counting
+			RigidBody rigidBody = state.world.getRigidBody(index);
+			updateForce(std::shared_ptr<RigidBody>(std::shared_ptr<RigidBody>(), &rigidBody), duration);
+
+			state.forceAccumulators[index] += rigidBody.getForceAccumulator();
+			state.torqueAccumulators[index] += rigidBody.getTorqueAccumulator();
+		}
+	}
+}
@@ -8,11 +8,21 @@ namespace physicslib
 	}
 
 	/* Apply gravity at the rigidBody's center */
-	void RigidBodyGravityForceGenerator::updateForce(std::shared_ptr<RigidBody> rigidBody, const double duration) const
+	void RigidBodyGravityForceGenerator::updateForce(std::shared_ptr<RigidBody> rigidBody, const real duration) const
 	{
 		if (rigidBody->getInverseMass() != 0)
 		{
 			rigidBody->addForceAtPoint(m_gravity,rigidBody->getPosition());
 		}
 	}
+
+	/* Applied at the center of mass the gravity produces no torque */
+	void RigidBodyGravityForceGenerator::applyBatch(Span<const std::uint32_t> indices, const RigidBodyForceState& state, const real duration) const
+	{
+		const Kernel kernel = getKernel(state, duration);
+		for (std::uint32_t index : indices)
+		{
+			kernel(index);
+		}
+	}
 }
\ No newline at end of file
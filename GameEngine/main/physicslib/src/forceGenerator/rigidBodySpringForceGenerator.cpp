@@ -4,17 +4,67 @@ namespace physicslib
 {
 	RigidBodySpringForceGenerator::RigidBodySpringForceGenerator(Vector3 extremity1, Vector3 extremity2, 
 		const std::shared_ptr<const RigidBody> otherRigidBody,
-		double elasticity, double restingLength)
+		real elasticity, real restingLength)
 		: m_extremity1(extremity1), m_extremity2(extremity2), m_otherRigidBody(otherRigidBody), m_elasticity(elasticity), m_restingLength(restingLength)
 	{}
 
+	RigidBodySpringForceGenerator::RigidBodySpringForceGenerator(Vector3 extremity1, Vector3 extremity2,
+		RigidBodyHandle otherRigidBody,
+		real elasticity, real restingLength)
+		: m_extremity1(extremity1), m_extremity2(extremity2), m_otherRigidBodyHandle(otherRigidBody), m_elasticity(elasticity), m_restingLength(restingLength)
+	{}
+
 	/* Apply spring forces to rigidBody : the spring is attached to extremity1 on rigidBody and extremity2 on otherRigidBody */
-	void RigidBodySpringForceGenerator::updateForce(std::shared_ptr<RigidBody> rigidBody, const double duration) const
+	void RigidBodySpringForceGenerator::updateForce(std::shared_ptr<RigidBody> rigidBody, const real duration) const
+	{
+		if (!m_otherRigidBody)
+		{
+			return;
+		}
+
+		// Convert the extremities to coordinates relative to the world
+		const Vector3 extremity1 = rigidBody->getWorldTransformMatrix() * m_extremity1;
+		const Vector3 extremity2 = m_otherRigidBody->getWorldTransformMatrix() * m_extremity2;
+
+		rigidBody->addForceAtPoint(getForce(extremity1, extremity2), extremity1);
+	}
+
+	void RigidBodySpringForceGenerator::applyBatch(Span<const std::uint32_t> indices, const RigidBodyForceState& state, const real duration) const
+	{
+		if (m_otherRigidBody)
+		{
+			RigidBodyForceGenerator::applyBatch(indices, state, duration);
+			return;
+		}
+
+		if (!state.world.isValid(m_otherRigidBodyHandle))
+		{
+			return;
+		}
+
+		// The other body gets the opposite force, it wakes up if it sleeps
+		Span<const Matrix34> worldTransformMatrices = state.world.getWorldTransformMatrices();
+		const std::size_t otherIndex = state.world.getIndex(m_otherRigidBodyHandle);
+		const Vector3 extremity2 = worldTransformMatrices[otherIndex] * m_extremity2;
+		for (std::uint32_t index : indices)
+		{
+			const Vector3 extremity1 = worldTransformMatrices[index] * m_extremity1;
+			const Vector3 force = getForce(extremity1, extremity2);
+			state.addForceAtPoint(index, force, extremity1);
+			state.addReactionAtPoint(otherIndex, -force, extremity2);
+		}
+	}
+
+	bool RigidBodySpringForceGenerator::isWakingUp(const RigidBodyWorld& world, std::size_t /*index*/) const
+	{
+		return !m_otherRigidBody && world.isValid(m_otherRigidBodyHandle) && world.isAwake(world.getIndex(m_otherRigidBodyHandle));
+	}
+
+	Vector3 RigidBodySpringForceGenerator::getForce(const Vector3& extremity1, const Vector3& extremity2) const
 	{
 		// Compute spring length
-		Vector3 d = m_extremity1 - m_extremity2;
+		Vector3 d = extremity1 - extremity2;
 
-		// Apply Force
-		rigidBody->addForceAtPoint(d.getNormalizedVector() * (-m_elasticity) * (d.getNorm() - m_restingLength), m_extremity1);
+		return d.getNormalizedVector() * (-m_elasticity) * (d.getNorm() - m_restingLength);
 	}
-}
\ No newline at end of file
+}
@@ -0,0 +1,100 @@
+#include "massProperties.hpp"
+
+namespace physicslib
+{
+	namespace
+	{
+		/**
+		 * Sums of powers of one coordinate over a triangle, shared by the integrals
+		 */
+		struct Subexpressions
+		{
+			real f1, f2, f3, g0, g1, g2;
+
+			Subexpressions(real w0, real w1, real w2)
+			{
+				const real temp0 = w0 + w1;
+				const real temp1 = w0 * w0;
+				const real temp2 = temp1 + w1 * temp0;
+				f1 = temp0 + w2;
+				f2 = temp2 + w2 * f1;
+				f3 = w0 * temp1 + w1 * temp2 + w2 * f2;
+				g0 = f2 + w0 * (f1 + w0);
+				g1 = f2 + w1 * (f1 + w1);
+				g2 = f2 + w2 * (f1 + w2);
+			}
+		};
+	}
+
+	MassProperties computeMassProperties(Span<const Vector3> vertices, Span<const std::uint32_t> indices)
+	{
+		MassProperties properties;
+		if (vertices.size() == 0 || indices.size() < 3)
+		{
+			return properties;
+		}
+
+		// The integrals are computed around a vertex of the mesh rather than the origin, which keeps their precision far from the origin
+		const Vector3 reference = vertices[0];
+
+		// Integrals of 1, x, y, z, x², y², z², xy, yz, zx over the volume
+		real integrals[10] = {};
+		for (std::size_t i = 0; i + 2 < indices.size(); i += 3)
+		{
+			const Vector3 p0 = vertices[indices[i]] - reference;
+			const Vector3 p1 = vertices[indices[i + 1]] - reference;
+			const Vector3 p2 = vertices[indices[i + 2]] - reference;
+			const Vector3 normal = (p1 - p0) ^ (p2 - p0);
+
+			const Subexpressions x(p0.getX(), p1.getX(), p2.getX());
+			const Subexpressions y(p0.getY(), p1.getY(), p2.getY());
+			const Subexpressions z(p0.getZ(), p1.getZ(), p2.getZ());
+
+			integrals[0] += normal.getX() * x.f1;
+			integrals[1] += normal.getX() * x.f2;
+			integrals[2] += normal.getY() * y.f2;
+			integrals[3] += normal.getZ() * z.f2;
+			integrals[4] += normal.getX() * x.f3;
+			integrals[5] += normal.getY() * y.f3;
+			integrals[6] += normal.getZ() * z.f3;
+			integrals[7] += normal.getX() * (p0.getY() * x.g0 + p1.getY() * x.g1 + p2.getY() * x.g2);
+			integrals[8] += normal.getY() * (p0.getZ() * y.g0 + p1.getZ() * y.g1 + p2.getZ() * y.g2);
+			integrals[9] += normal.getZ() * (p0.getX() * z.g0 + p1.getX() * z.g1 + p2.getX() * z.g2);
+		}
+
+		const real factors[10] = { real(1) / 6, real(1) / 24, real(1) / 24, real(1) / 24, real(1) / 60, real(1) / 60, real(1) / 60, real(1) / 120, real(1) / 120, real(1) / 120 };
+		for (std::size_t i = 0; i < 10; ++i)
+		{
+			integrals[i] *= factors[i];
+		}
+
+		const real volume = integrals[0];
+		if (volume == 0)
+		{
+			return properties;
+		}
+
+		const Vector3 center(integrals[1] / volume, integrals[2] / volume, integrals[3] / volume);
+		const real cx = center.getX();
+		const real cy = center.getY();
+		const real cz = center.getZ();
+
+		// Parallel axis theorem: from the reference point to the center of mass
+		const real xx = integrals[5] + integrals[6] - volume * (cy * cy + cz * cz);
+		const real yy = integrals[4] + integrals[6] - volume * (cz * cz + cx * cx);
+		const real zz = integrals[4] + integrals[5] - volume * (cx * cx + cy * cy);
+		const real xy = integrals[7] - volume * cx * cy;
+		const real yz = integrals[8] - volume * cy * cz;
+		const real xz = integrals[9] - volume * cz * cx;
+
+		properties.volume = volume;
+		properties.centerOfMass = center + reference;
+		properties.inertiaTensor = Matrix3({
+			xx, -xy, -xz,
+			-xy, yy, -yz,
+			-xz, -yz, zz
+		});
+
+		return properties;
+	}
+}
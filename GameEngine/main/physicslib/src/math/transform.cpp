@@ -0,0 +1,81 @@
+#include "math/transform.hpp"
+
+#include <cassert>
+#include "math/simd.hpp"
+
+namespace physicslib
+{
+	namespace
+	{
+		/**
+		 * out[i] = rotation * points[i] + translation
+		 * `rotation` is read row by row with a stride of `rowStride` doubles
+		 *
+		 * Vector3 is 3 packed doubles (see the static_asserts in vector3.hpp),
+		 * so 4 points are 3 full registers.
+		 */
+		void transformPoints(const real* rotation, std::size_t rowStride, const Vector3& translation,
+			Span<const Vector3> points, Span<Vector3> out)
+		{
+			assert(points.size() == out.size());
+
+			const real* pointData = reinterpret_cast<const real*>(points.data());
+			real* outData = reinterpret_cast<real*>(out.data());
+
+			simd::Register coefficients[3][3];
+			for (std::size_t row = 0; row < 3; ++row)
+			{
+				for (std::size_t column = 0; column < 3; ++column)
+				{
+					coefficients[row][column] = simd::splat(rotation[row * rowStride + column]);
+				}
+			}
+			const simd::Register translationX = simd::splat(translation.getX());
+			const simd::Register translationY = simd::splat(translation.getY());
+			const simd::Register translationZ = simd::splat(translation.getZ());
+
+			std::size_t i = 0;
+			for (; i + 4 <= points.size(); i += 4)
+			{
+				simd::Register x, y, z;
+				simd::deinterleave3(simd::load(pointData + 3 * i), simd::load(pointData + 3 * i + 4), simd::load(pointData + 3 * i + 8), x, y, z);
+
+				simd::Register newX = simd::add(simd::add(simd::add(simd::mul(coefficients[0][0], x), simd::mul(coefficients[0][1], y)), simd::mul(coefficients[0][2], z)), translationX);
+				simd::Register newY = simd::add(simd::add(simd::add(simd::mul(coefficients[1][0], x), simd::mul(coefficients[1][1], y)), simd::mul(coefficients[1][2], z)), translationY);
+				simd::Register newZ = simd::add(simd::add(simd::add(simd::mul(coefficients[2][0], x), simd::mul(coefficients[2][1], y)), simd::mul(coefficients[2][2], z)), translationZ);
+
+				simd::Register a, b, c;
+				simd::interleave3(newX, newY, newZ, a, b, c);
+				simd::store(outData + 3 * i, a);
+				simd::store(outData + 3 * i + 4, b);
+				simd::store(outData + 3 * i + 8, c);
+			}
+
+			// Remaining points one by one
+			for (; i < points.size(); ++i)
+			{
+				const Vector3& point = points[i];
+				out[i] = Vector3(
+					rotation[0] * point.getX() + rotation[1] * point.getY() + rotation[2] * point.getZ() + translation.getX(),
+					rotation[rowStride] * point.getX() + rotation[rowStride + 1] * point.getY() + rotation[rowStride + 2] * point.getZ() + translation.getY(),
+					rotation[2 * rowStride] * point.getX() + rotation[2 * rowStride + 1] * point.getY() + rotation[2 * rowStride + 2] * point.getZ() + translation.getZ()
+				);
+			}
+		}
+	}
+
+	void transformPoints(const Matrix3& matrix, Span<const Vector3> points, Span<Vector3> out)
+	{
+		transformPoints(matrix, Vector3(), points, out);
+	}
+
+	void transformPoints(const Matrix3& matrix, const Vector3& translation, Span<const Vector3> points, Span<Vector3> out)
+	{
+		transformPoints(&matrix(0, 0), 3, translation, points, out);
+	}
+
+	void transformPoints(const Matrix34& matrix, Span<const Vector3> points, Span<Vector3> out)
+	{
+		transformPoints(&matrix(0, 0), 4, Vector3(matrix(0, 3), matrix(1, 3), matrix(2, 3)), points, out);
+	}
+}
@@ -4,15 +4,15 @@
 
 namespace physicslib
 {
-	Particle::Particle(double inverseMass, physicslib::Vector3 position, physicslib::Vector3 speed, physicslib::Vector3 acceleration) :
+	Particle::Particle(real inverseMass, physicslib::Vector3 position, physicslib::Vector3 speed, physicslib::Vector3 acceleration) :
 		m_inverseMass(inverseMass), m_position(position), m_speed(speed), m_acceleration(acceleration), m_forceAccumulator()
 	{
 		std::random_device rd;  //Will be used to obtain a seed for the random number engine
 		std::mt19937 gen(rd()); //Standard mersenne_twister_engine seeded with rd()
-		std::uniform_real_distribution<> dis(0.0, 1.0);
-		double red = dis(gen);
-		double green = dis(gen);
-		double blue = dis(gen);
+		std::uniform_real_distribution<real> dis(0, 1);
+		real red = dis(gen);
+		real green = dis(gen);
+		real blue = dis(gen);
 		m_color = Vector3(red, green, blue);
 	}
 
@@ -29,8 +29,8 @@ namespace physicslib
 	//indicates whether or not a particle is visible or not on the screen
 	bool Particle::isVisible(unsigned int xMax, unsigned int yMax) const
 	{
-		double x = getPosition().getX();
-		double y = getPosition().getY();
+		real x = getPosition().getX();
+		real y = getPosition().getY();
 
 		return (x - 5 < xMax && x + 5 > 0 && y - 5 < yMax && y + 5 > 0);
 	}
@@ -41,17 +41,20 @@ namespace physicslib
 		return (getDistance(particle) <= 2. * PARTICLE_RADIUS);
 	}
 
-	double Particle::getDistance(const Particle& particle) const
+	real Particle::getDistance(const Particle& particle) const
 	{
 		return (m_position - particle.getPosition()).getNorm();
 	}
 
-	// Updates position, speed, acceleration using Newton laws
-	void Particle::integrate(double frameTime)
+	// Updates position, speed, acceleration using Newton laws, with the forces accumulated for this frame
+	void Particle::integrate(real frameTime, Integrator integrator)
 	{
-		setPosition(m_position + m_speed * frameTime);
-		setSpeed(m_speed + m_acceleration * frameTime);
-		m_acceleration = m_forceAccumulator;
+		integrator::visit(integrator, [this, frameTime](auto policy)
+		{
+			const Vector3 acceleration = m_forceAccumulator;
+			policy.integrateLinear(m_position, m_speed, m_acceleration, acceleration, frameTime);
+			m_acceleration = acceleration;
+		});
 		clearAccumulator();
 	}
 
@@ -80,7 +83,7 @@ namespace physicslib
 		m_position = newPosition;
 	}
 
-	double Particle::getInverseMass() const
+	real Particle::getInverseMass() const
 	{
 		return m_inverseMass;
 	}
@@ -1,112 +1,131 @@
 #include "rigidBody.hpp"
 
+#include <cmath>
 #include <iostream>
+#include "math/transform.hpp"
 
 namespace physicslib
 {
 	RigidBody::RigidBody(
-		const double mass, const double angularDamping, const Vector3 boxSize,
+		const real mass, const real angularDamping, const Vector3 boxSize,
 		const Vector3 initialPosition, const Vector3 initialVelocity, const Vector3 initialAcceleration,
 		const Quaternion initialOrientation, const Vector3 initialAngularVelocity, const Vector3 initialAngularAcceleration
 	)
-		: m_inverseMass(1. / mass)
-		, m_angularDamping(angularDamping)
+		: m_inverseMass(1 / mass)
 		, m_position(initialPosition)
 		, m_velocity(initialVelocity)
 		, m_acceleration(initialAcceleration)
 		, m_orientation(initialOrientation)
 		, m_angularVelocity(initialAngularVelocity)
 		, m_angularAcceleration(initialAngularAcceleration)
+		, m_angularDamping(angularDamping)
 		, m_boxSize(boxSize)
+		, m_localInverseInertiaTensor(CollisionShape::getBoxInverseInertiaTensor(boxSize) * m_inverseMass)
 	{
-		// Hardcoded box inertia tensor
-		double k = mass / 12.;
-		m_localInverseInertiaTensor = Matrix3({
-			k * (boxSize.getY() * boxSize.getY() + boxSize.getZ() * boxSize.getZ()), 0, 0,
-			0, k * (boxSize.getX() * boxSize.getX() + boxSize.getZ() * boxSize.getZ()), 0,
-			0, 0, k * (boxSize.getX() * boxSize.getX() + boxSize.getY() * boxSize.getY())
-		}).getReverseMatrix();
 	}
 
 	RigidBody::RigidBody(
-		const double mass, const double angularDamping, const std::vector<Vector3>& points,
+		const real mass, const real angularDamping, const CollisionShape& shape,
 		const Vector3 initialPosition, const Vector3 initialVelocity, const Vector3 initialAcceleration,
 		const Quaternion initialOrientation, const Vector3 initialAngularVelocity, const Vector3 initialAngularAcceleration
 	)
-		: m_inverseMass(1. / mass)
+		: m_inverseMass(1 / mass)
+		, m_position(initialPosition)
+		, m_velocity(initialVelocity)
+		, m_acceleration(initialAcceleration)
+		, m_orientation(initialOrientation)
+		, m_angularVelocity(initialAngularVelocity)
+		, m_angularAcceleration(initialAngularAcceleration)
 		, m_angularDamping(angularDamping)
+		, m_boxSize(shape.getBoxSize())
+		, m_localInverseInertiaTensor(shape.getLocalInverseInertiaTensor(m_inverseMass))
+	{
+	}
+
+	RigidBody::RigidBody(
+		const real mass, const real angularDamping, const std::vector<Vector3>& points,
+		const Vector3 initialPosition, const Vector3 initialVelocity, const Vector3 initialAcceleration,
+		const Quaternion initialOrientation, const Vector3 initialAngularVelocity, const Vector3 initialAngularAcceleration
+	)
+		: m_inverseMass(1 / mass)
 		, m_position(initialPosition)
 		, m_velocity(initialVelocity)
 		, m_acceleration(initialAcceleration)
 		, m_orientation(initialOrientation)
 		, m_angularVelocity(initialAngularVelocity)
 		, m_angularAcceleration(initialAngularAcceleration)
+		, m_angularDamping(angularDamping)
 	{
-		Vector3 xAxis = Vector3(1, 0, 0);
-		Vector3 yAxis = Vector3(0, 1, 0);
-		Vector3 zAxis = Vector3(0, 0, 1);
-
-		double xInertia = 0.;
-		double yInertia = 0.;
-		double zInertia = 0.;
-
-		double xyInertia = 0.;
-		double yzInertia = 0.;
-		double xzInertia = 0.;
-		for (Vector3 point : points)
+		// The shape is the solid hull of the points, its center of mass becomes the position of the body
+		std::vector<Vector3> localPoints;
+		localPoints.reserve(points.size());
+		for (const Vector3& point : points)
 		{
-			double xScalarProduct = (point - m_position).ScalarProduct(xAxis);
-			double yScalarProduct = (point - m_position).ScalarProduct(yAxis);
-			double zScalarProduct = (point - m_position).ScalarProduct(zAxis);
-
-			// Compute moment of inertia
-			xInertia += mass * (yScalarProduct * yScalarProduct + zScalarProduct * zScalarProduct);
-			yInertia += mass * (xScalarProduct * xScalarProduct + zScalarProduct * zScalarProduct);
-			zInertia += mass * (xScalarProduct * xScalarProduct + yScalarProduct * yScalarProduct);
-
-			// Compute inertia product
-			xyInertia += mass * xScalarProduct * yScalarProduct;
-			xzInertia += mass * xScalarProduct * zScalarProduct;
-			yzInertia += mass * yScalarProduct * zScalarProduct;
+			localPoints.push_back(point - initialPosition);
 		}
 
-		m_localInverseInertiaTensor = Matrix3({
-			xInertia, -xyInertia, -xzInertia,
-			-xyInertia, yInertia, -yzInertia,
-			-xzInertia, -yzInertia, zInertia
-		});
-		m_localInverseInertiaTensor /= points.size();
-		m_localInverseInertiaTensor.reverse();
+		const CollisionShape shape = CollisionShape::createConvexHull(localPoints);
+		m_position += shape.getCenterOfMass();
+		m_boxSize = shape.getBoxSize();
+		m_localInverseInertiaTensor = shape.getLocalInverseInertiaTensor(m_inverseMass);
 	}
 
-	void RigidBody::integrate(double frameTime)
+	void RigidBody::integrate(real frameTime, Integrator integrator)
 	{
-		// Position update
-		m_acceleration = m_forceAccumulator;
-		m_velocity = m_velocity + m_acceleration * frameTime;
-		m_position = m_position + m_velocity * frameTime;
-
-		// Orientation update
-		m_angularAcceleration = m_globalInverseInertiaTensor * m_torqueAccumulator;
-		m_angularVelocity = m_angularVelocity * pow(m_angularDamping, frameTime) + m_angularAcceleration * frameTime;
-		m_orientation.updateOrientation(m_angularVelocity, frameTime);
-		
-		computeDerivedData();
+		integrator::visit(integrator, [this, frameTime](auto policy)
+		{
+			// Position update
+			const Vector3 acceleration = m_forceAccumulator;
+			policy.integrateLinear(m_position, m_velocity, m_acceleration, acceleration, frameTime);
+			m_acceleration = acceleration;
+			m_isWorldTransformDirty = true;
+
+			// Orientation update
+			updateRotationData();
+			const Vector3 angularAcceleration = m_globalInverseInertiaTensor * m_torqueAccumulator;
+			if (policy.integrateAngular(m_orientation, m_angularVelocity, m_angularAcceleration, angularAcceleration, m_angularDamping, frameTime))
+			{
+				// The derived data only has to be recomputed when the body actually turns
+				m_isRotationDirty = true;
+			}
+			m_angularAcceleration = angularAcceleration;
+		});
+
 		clearAccumulators();
 	}
 
-	void RigidBody::computeDerivedData()
+	void RigidBody::computeDerivedData() const
 	{
+		updateRotationData();
+
+		if (m_isWorldTransformDirty)
+		{
+			m_worldTransformMatrix = Matrix34(m_transformMatrix, m_position);
+			m_isWorldTransformDirty = false;
+		}
+	}
+
+	void RigidBody::updateRotationData() const
+	{
+		if (!m_isRotationDirty)
+		{
+			return;
+		}
+
 		m_transformMatrix = Matrix3(m_orientation);
 
-		m_globalInverseInertiaTensor = m_transformMatrix * m_localInverseInertiaTensor * m_transformMatrix.getReverseMatrix();
+		// The transform matrix is a rotation: its inverse is its transpose
+		m_globalInverseInertiaTensor = m_transformMatrix * m_localInverseInertiaTensor * m_transformMatrix.getRotationInverse();
+
+		m_isRotationDirty = false;
+		m_isWorldTransformDirty = true;
 	}
 
 	void RigidBody::addForceAtPoint(const Vector3& force, const Vector3& point)
 	{
 		// Convert point to coordinates relative to the center-of-mass
-		Vector3 localPoint = point - m_position;
-		localPoint = localPoint.worldToLocal(m_transformMatrix);
+		updateRotationData();
+		Vector3 localPoint = m_transformMatrix.getRotationInverse() * (point - m_position);
 
 		m_forceAccumulator += force;
 		m_torqueAccumulator += localPoint.CrossProduct(force);
@@ -115,6 +134,7 @@ namespace physicslib
 	void RigidBody::addForceAtBodyPoint(const Vector3& force, const Vector3& point)
 	{
 		// Convert point to coordinates relative to the world
+		updateRotationData();
 		Vector3 worldPoint = point.localToWorld(m_transformMatrix);
 		worldPoint += m_position;
 
@@ -127,18 +147,15 @@ namespace physicslib
 		m_torqueAccumulator = physicslib::Vector3();
 	}
 
-	std::vector<double> RigidBody::getBoxVertices() const
+	std::vector<real> RigidBody::getBoxVertices() const
 	{
-		std::vector<Vector3> vertices = getBoxLocalVertices();
-		std::transform(vertices.begin(), vertices.end(), vertices.begin(),
-			[this](const Vector3& vertex)
-			{
-				return vertex.localToWorld(m_transformMatrix) + m_position;
-			});
+		std::array<Vector3, BOX_VERTEX_COUNT> vertices;
+		getBoxVertices(vertices);
 
-		std::vector<double> verticesDouble;
+		std::vector<real> verticesDouble;
+		verticesDouble.reserve(3 * BOX_VERTEX_COUNT);
 
-		for (const Vector3 vertex : vertices)
+		for (const Vector3& vertex : vertices)
 		{
 			verticesDouble.push_back(vertex.getX());
 			verticesDouble.push_back(vertex.getY());
@@ -148,58 +165,15 @@ namespace physicslib
 		return verticesDouble;
 	}
 
-	std::vector<Vector3> RigidBody::getBoxLocalVertices() const
+	void RigidBody::getBoxVertices(Span<Vector3> vertices) const
 	{
-		std::vector<Vector3> vertices =
-		{
-			{ - m_boxSize.getX() / 2,  - m_boxSize.getY() / 2,  - m_boxSize.getZ() / 2 },
-			{ + m_boxSize.getX() / 2,  - m_boxSize.getY() / 2,  - m_boxSize.getZ() / 2 },
-			{ + m_boxSize.getX() / 2,  + m_boxSize.getY() / 2,  - m_boxSize.getZ() / 2 },
-			{ + m_boxSize.getX() / 2,  + m_boxSize.getY() / 2,  - m_boxSize.getZ() / 2 },
-			{ - m_boxSize.getX() / 2,  + m_boxSize.getY() / 2,  - m_boxSize.getZ() / 2 },
-			{ - m_boxSize.getX() / 2,  - m_boxSize.getY() / 2,  - m_boxSize.getZ() / 2 },
-
-			{ - m_boxSize.getX() / 2,  - m_boxSize.getY() / 2,  + m_boxSize.getZ() / 2 },
-			{ + m_boxSize.getX() / 2,  - m_boxSize.getY() / 2,  + m_boxSize.getZ() / 2 },
-			{ + m_boxSize.getX() / 2,  + m_boxSize.getY() / 2,  + m_boxSize.getZ() / 2 },
-			{ + m_boxSize.getX() / 2,  + m_boxSize.getY() / 2,  + m_boxSize.getZ() / 2 },
-			{ - m_boxSize.getX() / 2,  + m_boxSize.getY() / 2,  + m_boxSize.getZ() / 2 },
-			{ - m_boxSize.getX() / 2,  - m_boxSize.getY() / 2,  + m_boxSize.getZ() / 2 },
-
-			{ - m_boxSize.getX() / 2,  + m_boxSize.getY() / 2,  + m_boxSize.getZ() / 2 },
-			{ - m_boxSize.getX() / 2,  + m_boxSize.getY() / 2,  - m_boxSize.getZ() / 2 },
-			{ - m_boxSize.getX() / 2,  - m_boxSize.getY() / 2,  - m_boxSize.getZ() / 2 },
-			{ - m_boxSize.getX() / 2,  - m_boxSize.getY() / 2,  - m_boxSize.getZ() / 2 },
-			{ - m_boxSize.getX() / 2,  - m_boxSize.getY() / 2,  + m_boxSize.getZ() / 2 },
-			{ - m_boxSize.getX() / 2,  + m_boxSize.getY() / 2,  + m_boxSize.getZ() / 2 },
-
-			{ + m_boxSize.getX() / 2,  + m_boxSize.getY() / 2,  + m_boxSize.getZ() / 2 },
-			{ + m_boxSize.getX() / 2,  + m_boxSize.getY() / 2,  - m_boxSize.getZ() / 2 },
-			{ + m_boxSize.getX() / 2,  - m_boxSize.getY() / 2,  - m_boxSize.getZ() / 2 },
-			{ + m_boxSize.getX() / 2,  - m_boxSize.getY() / 2,  - m_boxSize.getZ() / 2 },
-			{ + m_boxSize.getX() / 2,  - m_boxSize.getY() / 2,  + m_boxSize.getZ() / 2 },
-			{ + m_boxSize.getX() / 2,  + m_boxSize.getY() / 2,  + m_boxSize.getZ() / 2 },
-
-			{ - m_boxSize.getX() / 2,  - m_boxSize.getY() / 2,  - m_boxSize.getZ() / 2 },
-			{ + m_boxSize.getX() / 2,  - m_boxSize.getY() / 2,  - m_boxSize.getZ() / 2 },
-			{ + m_boxSize.getX() / 2,  - m_boxSize.getY() / 2,  + m_boxSize.getZ() / 2 },
-			{ + m_boxSize.getX() / 2,  - m_boxSize.getY() / 2,  + m_boxSize.getZ() / 2 },
-			{ - m_boxSize.getX() / 2,  - m_boxSize.getY() / 2,  + m_boxSize.getZ() / 2 },
-			{ - m_boxSize.getX() / 2,  - m_boxSize.getY() / 2,  - m_boxSize.getZ() / 2 },
-
-			{ - m_boxSize.getX() / 2,  + m_boxSize.getY() / 2,  - m_boxSize.getZ() / 2},
-			{ + m_boxSize.getX() / 2,  + m_boxSize.getY() / 2,  - m_boxSize.getZ() / 2},
-			{ + m_boxSize.getX() / 2,  + m_boxSize.getY() / 2,  + m_boxSize.getZ() / 2},
-			{ + m_boxSize.getX() / 2,  + m_boxSize.getY() / 2,  + m_boxSize.getZ() / 2},
-			{ - m_boxSize.getX() / 2,  + m_boxSize.getY() / 2,  + m_boxSize.getZ() / 2},
-			{ - m_boxSize.getX() / 2,  + m_boxSize.getY() / 2,  - m_boxSize.getZ() / 2},
-		};
-		return vertices;
+		const std::array<Vector3, BOX_VERTEX_COUNT> localVertices = CollisionShape::getBoxLocalVertices(m_boxSize);
+		transformPoints(getWorldTransformMatrix(), localVertices, vertices);
 	}
 
 	#pragma region Getters/Setters
 
-	double RigidBody::getInverseMass() const
+	real RigidBody::getInverseMass() const
 	{
 		return m_inverseMass;
 	}
@@ -229,11 +203,28 @@ namespace physicslib
 		return m_angularVelocity;
 	}
 
+	physicslib::Vector3 RigidBody::getForceAccumulator() const
+	{
+		return m_forceAccumulator;
+	}
+
+	physicslib::Vector3 RigidBody::getTorqueAccumulator() const
+	{
+		return m_torqueAccumulator;
+	}
+
 	physicslib::Matrix3 RigidBody::getTransformMatrix() const
 	{
+		updateRotationData();
 		return m_transformMatrix;
 	}
 
+	physicslib::Matrix34 RigidBody::getWorldTransformMatrix() const
+	{
+		computeDerivedData();
+		return m_worldTransformMatrix;
+	}
+
 	physicslib::Vector3 RigidBody::getBoxSize() const
 	{
 		return m_boxSize;
@@ -242,6 +233,7 @@ namespace physicslib
 	void RigidBody::setPosition(physicslib::Vector3 position)
 	{
 		m_position = position;
+		m_isWorldTransformDirty = true;
 	}
 
 	void RigidBody::setVelocity(physicslib::Vector3 velocity)
@@ -257,6 +249,7 @@ namespace physicslib
 	void RigidBody::setOrientation(physicslib::Quaternion orientation)
 	{
 		m_orientation = orientation;
+		m_isRotationDirty = true;
 	}
 
 	void RigidBody::setAngularVelocity(physicslib::Vector3 rotation)
@@ -0,0 +1,495 @@
+#include "rigidBodyWorld.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include "math/expression.hpp"
+#include "math/transform.hpp"
+
+namespace physicslib
+{
+	RigidBodyHandle RigidBodyWorld::add(const RigidBody& rigidBody)
+	{
+		return add(rigidBody, m_collisionShapes.addBox(rigidBody.m_boxSize));
+	}
+
+	RigidBodyHandle RigidBodyWorld::add(const RigidBody& rigidBody, CollisionShapeId shape)
+	{
+		const std::size_t index = insert(shape, rigidBody.m_inverseMass, rigidBody.m_angularDamping,
+			rigidBody.m_position, rigidBody.m_velocity, rigidBody.m_acceleration,
+			rigidBody.m_orientation, rigidBody.m_angularVelocity, rigidBody.m_angularAcceleration);
+		m_forceAccumulators[index] = rigidBody.m_forceAccumulator;
+		m_torqueAccumulators[index] = rigidBody.m_torqueAccumulator;
+
+		return getHandle(index);
+	}
+
+	RigidBodyHandle RigidBodyWorld::add(
+		CollisionShapeId shape, real mass, real angularDamping,
+		const Vector3& position, const Vector3& velocity,
+		const Quaternion& orientation, const Vector3& angularVelocity
+	)
+	{
+		return getHandle(insert(shape, 1 / mass, angularDamping, position, velocity, Vector3(), orientation, angularVelocity, Vector3()));
+	}
+
+	std::size_t RigidBodyWorld::insert(
+		CollisionShapeId shape, real inverseMass, real angularDamping, const Vector3& position, const Vector3& velocity, const Vector3& acceleration,
+		const Quaternion& orientation, const Vector3& angularVelocity, const Vector3& angularAcceleration
+	)
+	{
+		const std::uint32_t index = static_cast<std::uint32_t>(getSize());
+
+		// Reuse a free slot when there is one, its generation was bumped by remove()
+		std::uint32_t slot;
+		if (!m_freeSlots.empty())
+		{
+			slot = m_freeSlots.back();
+			m_freeSlots.pop_back();
+		}
+		else
+		{
+			slot = static_cast<std::uint32_t>(m_slots.size());
+			m_slots.push_back({ RigidBodyHandle::INVALID_SLOT, 0 });
+		}
+		m_slots[slot].index = index;
+
+		m_slotsByIndex.push_back(slot);
+		m_inverseMasses.push_back(inverseMass);
+		m_angularDampings.push_back(angularDamping);
+		m_positions.push_back(position);
+		m_velocities.push_back(velocity);
+		m_accelerations.push_back(acceleration);
+		m_forceAccumulators.emplace_back();
+		m_orientations.push_back(orientation);
+		m_angularVelocities.push_back(angularVelocity);
+		m_angularAccelerations.push_back(angularAcceleration);
+		m_torqueAccumulators.emplace_back();
+		m_shapeIds.push_back(shape);
+		m_awakeFlags.push_back(true);
+		m_restTimes.push_back(0);
+		m_previousPositions.push_back(position);
+		m_previousOrientations.push_back(orientation);
+		m_transformMatrices.emplace_back();
+		m_globalInverseInertiaTensors.emplace_back();
+		m_worldTransformMatrices.emplace_back();
+		computeDerivedData(index);
+
+		return index;
+	}
+
+	void RigidBodyWorld::remove(RigidBodyHandle handle)
+	{
+		if (!isValid(handle))
+		{
+			return;
+		}
+
+		// The last body fills the hole so that the arrays stay packed
+		const std::size_t index = m_slots[handle.slot].index;
+		const std::size_t lastIndex = getSize() - 1;
+		m_slots[m_slotsByIndex[lastIndex]].index = static_cast<std::uint32_t>(index);
+		forEachArray([index](auto& array)
+		{
+			array[index] = array.back();
+			array.pop_back();
+		});
+
+		m_slots[handle.slot].index = RigidBodyHandle::INVALID_SLOT;
+		++m_slots[handle.slot].generation;
+		m_freeSlots.push_back(handle.slot);
+	}
+
+	void RigidBodyWorld::clear()
+	{
+		for (std::uint32_t slot : m_slotsByIndex)
+		{
+			m_slots[slot].index = RigidBodyHandle::INVALID_SLOT;
+			++m_slots[slot].generation;
+			m_freeSlots.push_back(slot);
+		}
+
+		forEachArray([](auto& array)
+		{
+			array.clear();
+		});
+	}
+
+	void RigidBodyWorld::reserve(std::size_t capacity)
+	{
+		m_slots.reserve(capacity);
+		m_freeSlots.reserve(capacity);
+		forEachArray([capacity](auto& array)
+		{
+			array.reserve(capacity);
+		});
+	}
+
+	bool RigidBodyWorld::isValid(RigidBodyHandle handle) const
+	{
+		return handle.slot < m_slots.size()
+			&& m_slots[handle.slot].index != RigidBodyHandle::INVALID_SLOT
+			&& m_slots[handle.slot].generation == handle.generation;
+	}
+
+	std::size_t RigidBodyWorld::getIndex(RigidBodyHandle handle) const
+	{
+		assert(isValid(handle));
+		return m_slots[handle.slot].index;
+	}
+
+	RigidBodyHandle RigidBodyWorld::getHandle(std::size_t index) const
+	{
+		const std::uint32_t slot = m_slotsByIndex[index];
+		return { slot, m_slots[slot].generation };
+	}
+
+	std::size_t RigidBodyWorld::getSize() const
+	{
+		return m_positions.size();
+	}
+
+	void RigidBodyWorld::integrate(real frameTime)
+	{
+		integrate(frameTime, 0, getSize());
+	}
+
+	void RigidBodyWorld::integrate(real frameTime, WorkerPool& workerPool)
+	{
+		workerPool.parallelFor(getSize(), INTEGRATION_CHUNK_SIZE, [this, frameTime](std::size_t begin, std::size_t end)
+		{
+			integrate(frameTime, begin, end);
+		});
+	}
+
+	void RigidBodyWorld::integrate(real frameTime, std::size_t begin, std::size_t end)
+	{
+		// The scheme is chosen once per chunk, the loops are compiled for each policy
+		integrator::visit(m_integrator, [this, frameTime, begin, end](auto policy)
+		{
+			integrate<decltype(policy)>(frameTime, begin, end);
+		});
+	}
+
+	template <typename Policy>
+	void RigidBodyWorld::integrate(real frameTime, std::size_t begin, std::size_t end)
+	{
+		// Position update, the sleeping bodies are skipped
+		for (std::size_t i = begin; i < end; ++i)
+		{
+			m_previousPositions[i] = m_positions[i];
+			if (!m_awakeFlags[i])
+			{
+				continue;
+			}
+
+			const Vector3 acceleration = m_forceAccumulators[i];
+			Policy::integrateLinear(m_positions[i], m_velocities[i], m_accelerations[i], acceleration, frameTime);
+			m_accelerations[i] = acceleration;
+		}
+
+		// Orientation update, only the bodies which turn need their rotation matrices recomputed
+		for (std::size_t i = begin; i < end; ++i)
+		{
+			m_previousOrientations[i] = m_orientations[i];
+			if (!m_awakeFlags[i])
+			{
+				continue;
+			}
+
+			const Vector3 angularAcceleration = m_globalInverseInertiaTensors[i] * m_torqueAccumulators[i];
+			const bool hasTurned = Policy::integrateAngular(m_orientations[i], m_angularVelocities[i], m_angularAccelerations[i], angularAcceleration, m_angularDampings[i], frameTime);
+			m_angularAccelerations[i] = angularAcceleration;
+			if (hasTurned)
+			{
+				computeDerivedData(i);
+			}
+			else
+			{
+				m_worldTransformMatrices[i] = Matrix34(m_transformMatrices[i], m_positions[i]);
+			}
+
+			updateSleep(i, frameTime);
+		}
+
+		std::fill(m_forceAccumulators.begin() + begin, m_forceAccumulators.begin() + end, Vector3());
+		std::fill(m_torqueAccumulators.begin() + begin, m_torqueAccumulators.begin() + end, Vector3());
+	}
+
+	bool RigidBodyWorld::isAwake(std::size_t index) const
+	{
+		return m_awakeFlags[index] != 0;
+	}
+
+	void RigidBodyWorld::setAwake(std::size_t index, bool isAwake)
+	{
+		if (isAwake == (m_awakeFlags[index] != 0))
+		{
+			return;
+		}
+
+		m_awakeFlags[index] = isAwake;
+		m_restTimes[index] = 0;
+		if (!isAwake)
+		{
+			// A sleeping body keeps no motion, it would be applied all at once on wake up
+			// The accelerations are kept: they are the previous accelerations of the step following the wake up
+			m_velocities[index] = Vector3();
+			m_angularVelocities[index] = Vector3();
+			m_forceAccumulators[index] = Vector3();
+			m_torqueAccumulators[index] = Vector3();
+		}
+	}
+
+	std::size_t RigidBodyWorld::getAwakeCount() const
+	{
+		return std::count(m_awakeFlags.begin(), m_awakeFlags.end(), std::uint8_t(1));
+	}
+
+	void RigidBodyWorld::setSleepParameters(real linearSpeed, real angularSpeed, real delay)
+	{
+		m_sleepLinearSpeed = linearSpeed;
+		m_sleepAngularSpeed = angularSpeed;
+		m_sleepDelay = delay;
+	}
+
+	void RigidBodyWorld::addForce(std::size_t index, const Vector3& force)
+	{
+		setAwake(index, true);
+		m_forceAccumulators[index] += force;
+	}
+
+	void RigidBodyWorld::addTorque(std::size_t index, const Vector3& torque)
+	{
+		setAwake(index, true);
+		m_torqueAccumulators[index] += torque;
+	}
+
+	void RigidBodyWorld::addForceAtPoint(std::size_t index, const Vector3& force, const Vector3& point)
+	{
+		// Convert point to coordinates relative to the center-of-mass
+		const Vector3 localPoint = m_transformMatrices[index].getRotationInverse() * (point - m_positions[index]);
+
+		setAwake(index, true);
+		m_forceAccumulators[index] += force;
+		m_torqueAccumulators[index] += localPoint.CrossProduct(force);
+	}
+
+	void RigidBodyWorld::addForceAtBodyPoint(std::size_t index, const Vector3& force, const Vector3& point)
+	{
+		// Convert point to coordinates relative to the world
+		addForceAtPoint(index, force, m_worldTransformMatrices[index] * point);
+	}
+
+	void RigidBodyWorld::getBoxVertices(Span<Vector3> vertices, real interpolation) const
+	{
+		for (std::size_t i = 0; i < getSize(); ++i)
+		{
+			Span<const Vector3> localVertices = m_collisionShapes.get(m_shapeIds[i]).getVertices();
+			Span<Vector3> bodyVertices = vertices.subspan(i * RigidBody::BOX_VERTEX_COUNT, RigidBody::BOX_VERTEX_COUNT);
+			if (interpolation >= 1)
+			{
+				transformPoints(m_worldTransformMatrices[i], localVertices, bodyVertices);
+				continue;
+			}
+
+			// Linear interpolation of the position, normalized linear interpolation of the orientation on the shortest arc
+			const Vector3 position = m_previousPositions[i] + expression::lazy(m_positions[i] - m_previousPositions[i]) * interpolation;
+			Quaternion previousOrientation = m_previousOrientations[i];
+			if (previousOrientation.ScalarProduct(m_orientations[i]) < 0)
+			{
+				previousOrientation = -previousOrientation;
+			}
+			Quaternion orientation = expression::lazy(previousOrientation) * (1 - interpolation) + expression::lazy(m_orientations[i]) * interpolation;
+			orientation.normalize();
+
+			transformPoints(Matrix34(Matrix3(orientation), position), localVertices, bodyVertices);
+		}
+	}
+
+	RigidBody RigidBodyWorld::getRigidBody(std::size_t index) const
+	{
+		const CollisionShape& shape = m_collisionShapes.get(m_shapeIds[index]);
+		RigidBody rigidBody(1, m_angularDampings[index], shape,
+			m_positions[index], m_velocities[index], m_accelerations[index],
+			m_orientations[index], m_angularVelocities[index], m_angularAccelerations[index]);
+		rigidBody.m_inverseMass = m_inverseMasses[index];
+		rigidBody.m_localInverseInertiaTensor = shape.getLocalInverseInertiaTensor(m_inverseMasses[index]);
+
+		return rigidBody;
+	}
+
+	void RigidBodyWorld::updateSleep(std::size_t index, real frameTime)
+	{
+		if (m_sleepDelay <= 0)
+		{
+			return;
+		}
+
+		const bool isResting = m_velocities[index].getSquaredNorm() < m_sleepLinearSpeed * m_sleepLinearSpeed
+			&& m_angularVelocities[index].getSquaredNorm() < m_sleepAngularSpeed * m_sleepAngularSpeed;
+		m_restTimes[index] = isResting ? m_restTimes[index] + frameTime : 0;
+
+		if (m_restTimes[index] >= m_sleepDelay)
+		{
+			setAwake(index, false);
+		}
+	}
+
+	void RigidBodyWorld::computeDerivedData(std::size_t index)
+	{
+		m_transformMatrices[index] = Matrix3(m_orientations[index]);
+
+		// The transform matrix is a rotation: its inverse is its transpose
+		const Matrix3 localInverseInertiaTensor = m_collisionShapes.get(m_shapeIds[index]).getLocalInverseInertiaTensor(m_inverseMasses[index]);
+		m_globalInverseInertiaTensors[index] = m_transformMatrices[index] * localInverseInertiaTensor * m_transformMatrices[index].getRotationInverse();
+		m_worldTransformMatrices[index] = Matrix34(m_transformMatrices[index], m_positions[index]);
+	}
+
+	#pragma region Getters/Setters
+
+	real RigidBodyWorld::getInverseMass(std::size_t index) const
+	{
+		return m_inverseMasses[index];
+	}
+
+	Vector3 RigidBodyWorld::getPosition(std::size_t index) const
+	{
+		return m_positions[index];
+	}
+
+	Vector3 RigidBodyWorld::getVelocity(std::size_t index) const
+	{
+		return m_velocities[index];
+	}
+
+	Vector3 RigidBodyWorld::getAcceleration(std::size_t index) const
+	{
+		return m_accelerations[index];
+	}
+
+	Quaternion RigidBodyWorld::getOrientation(std::size_t index) const
+	{
+		return m_orientations[index];
+	}
+
+	Vector3 RigidBodyWorld::getAngularVelocity(std::size_t index) const
+	{
+		return m_angularVelocities[index];
+	}
+
+	Matrix3 RigidBodyWorld::getTransformMatrix(std::size_t index) const
+	{
+		return m_transformMatrices[index];
+	}
+
+	Matrix34 RigidBodyWorld::getWorldTransformMatrix(std::size_t index) const
+	{
+		return m_worldTransformMatrices[index];
+	}
+
+	Vector3 RigidBodyWorld::getBoxSize(std::size_t index) const
+	{
+		return m_collisionShapes.get(m_shapeIds[index]).getBoxSize();
+	}
+
+	CollisionShapeId RigidBodyWorld::getCollisionShapeId(std::size_t index) const
+	{
+		return m_shapeIds[index];
+	}
+
+	CollisionShapeRegistry& RigidBodyWorld::getCollisionShapes()
+	{
+		return m_collisionShapes;
+	}
+
+	const CollisionShapeRegistry& RigidBodyWorld::getCollisionShapes() const
+	{
+		return m_collisionShapes;
+	}
+
+	Span<const CollisionShapeId> RigidBodyWorld::getCollisionShapeIds() const
+	{
+		return m_shapeIds;
+	}
+
+	Span<const real> RigidBodyWorld::getInverseMasses() const
+	{
+		return m_inverseMasses;
+	}
+
+	Span<const Vector3> RigidBodyWorld::getPositions() const
+	{
+		return m_positions;
+	}
+
+	Span<const Vector3> RigidBodyWorld::getVelocities() const
+	{
+		return m_velocities;
+	}
+
+	Span<const Quaternion> RigidBodyWorld::getOrientations() const
+	{
+		return m_orientations;
+	}
+
+	Span<const Vector3> RigidBodyWorld::getAngularVelocities() const
+	{
+		return m_angularVelocities;
+	}
+
+	Span<const Matrix34> RigidBodyWorld::getWorldTransformMatrices() const
+	{
+		return m_worldTransformMatrices;
+	}
+
+	Integrator RigidBodyWorld::getIntegrator() const
+	{
+		return m_integrator;
+	}
+
+	Span<Vector3> RigidBodyWorld::getForceAccumulators()
+	{
+		return m_forceAccumulators;
+	}
+
+	Span<Vector3> RigidBodyWorld::getTorqueAccumulators()
+	{
+		return m_torqueAccumulators;
+	}
+
+	void RigidBodyWorld::setPosition(std::size_t index, Vector3 position)
+	{
+		setAwake(index, true);
+		m_positions[index] = position;
+		m_previousPositions[index] = position;
+		m_worldTransformMatrices[index] = Matrix34(m_transformMatrices[index], position);
+	}
+
+	void RigidBodyWorld::setVelocity(std::size_t index, Vector3 velocity)
+	{
+		setAwake(index, true);
+		m_velocities[index] = velocity;
+	}
+
+	void RigidBodyWorld::setOrientation(std::size_t index, Quaternion orientation)
+	{
+		setAwake(index, true);
+		m_orientations[index] = orientation;
+		m_previousOrientations[index] = orientation;
+		computeDerivedData(index);
+	}
+
+	void RigidBodyWorld::setAngularVelocity(std::size_t index, Vector3 angularVelocity)
+	{
+		setAwake(index, true);
+		m_angularVelocities[index] = angularVelocity;
+	}
+
+	void RigidBodyWorld::setIntegrator(Integrator integrator)
+	{
+		m_integrator = integrator;
+	}
+
+	#pragma endregion
+}
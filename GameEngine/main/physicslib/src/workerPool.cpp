@@ -0,0 +1,108 @@
+#include "workerPool.hpp"
+
+#include <algorithm>
+
+namespace physicslib
+{
+	WorkerPool::WorkerPool(std::size_t threadCount)
+	{
+		if (threadCount == 0)
+		{
+			threadCount = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+		}
+
+		// The calling thread takes part in the loops
+		m_workers.reserve(threadCount - 1);
+		for (std::size_t i = 1; i < threadCount; ++i)
+		{
+			m_workers.emplace_back(&WorkerPool::workerLoop, this);
+		}
+	}
+
+	WorkerPool::~WorkerPool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_isStopping = true;
+		}
+		m_jobCondition.notify_all();
+
+		for (std::thread& worker : m_workers)
+		{
+			worker.join();
+		}
+	}
+
+	std::size_t WorkerPool::getThreadCount() const
+	{
+		return m_workers.size() + 1;
+	}
+
+	void WorkerPool::run(std::size_t count, std::size_t chunkSize, ChunkFunction function, const void* context)
+	{
+		chunkSize = std::max<std::size_t>(1, chunkSize);
+
+		// Not worth waking the workers up for a single chunk
+		if (m_workers.empty() || count <= chunkSize)
+		{
+			if (count > 0)
+			{
+				function(context, 0, count);
+			}
+			return;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_function = function;
+			m_context = context;
+			m_count = count;
+			m_chunkSize = chunkSize;
+			m_nextChunk.store(0, std::memory_order_relaxed);
+			m_busyWorkerCount = m_workers.size();
+			++m_jobId;
+		}
+		m_jobCondition.notify_all();
+
+		runChunks();
+
+		// The loop is over when every worker has left it: only then can the job data be replaced
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_doneCondition.wait(lock, [this]() { return m_busyWorkerCount == 0; });
+	}
+
+	void WorkerPool::runChunks()
+	{
+		const std::size_t chunkCount = (m_count + m_chunkSize - 1) / m_chunkSize;
+		for (std::size_t chunk = m_nextChunk.fetch_add(1); chunk < chunkCount; chunk = m_nextChunk.fetch_add(1))
+		{
+			const std::size_t begin = chunk * m_chunkSize;
+			m_function(m_context, begin, std::min(begin + m_chunkSize, m_count));
+		}
+	}
+
+	void WorkerPool::workerLoop()
+	{
+		std::uint64_t lastJobId = 0;
+		while (true)
+		{
+			{
+				std::unique_lock<std::mutex> lock(m_mutex);
+				m_jobCondition.wait(lock, [this, lastJobId]() { return m_isStopping || m_jobId != lastJobId; });
+				if (m_isStopping)
+				{
+					return;
+				}
+				lastJobId = m_jobId;
+			}
+
+			runChunks();
+
+			std::lock_guard<std::mutex> lock(m_mutex);
+			if (--m_busyWorkerCount == 0)
+			{
+				m_doneCondition.notify_one();
+			}
+		}
+	}
+}
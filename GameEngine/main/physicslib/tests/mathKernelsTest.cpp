@@ -0,0 +1,358 @@
+/*
+ * Tolerance test of the SIMD backends of the math library
+ *
+ * Runs the Vector3, Quaternion, Matrix3 and Matrix34 kernels on fixed pseudo-random inputs. The scalar build of the
+ * test writes its results in a reference file, the builds of the other backends compare their results with it:
+ * each value must be within MAX_ULP units in the last place of the scalar one. The backends evaluate their
+ * operations in the same order as the scalar code, so the results are expected to be identical; the tolerance only
+ * leaves room for a compiler contracting a multiplication and an addition in a single rounding.
+ *
+ * Usage: physicslib_tests_<backend>_<real> --write <referenceFile>
+ *        physicslib_tests_<backend>_<real> <referenceFile>
+ */
+#include <cinttypes>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "math/matrix3.hpp"
+#include "math/matrix34.hpp"
+#include "math/quaternion.hpp"
+#include "math/real.hpp"
+#include "math/simd.hpp"
+#include "math/vector3.hpp"
+
+namespace
+{
+	const std::uint64_t MAX_ULP = 4;
+	const std::size_t SAMPLE_COUNT = 1000;
+	const int SKIP_EXIT_CODE = 77; // SKIP_RETURN_CODE of the test, when the CPU lacks the instruction set
+
+	using Bits = std::conditional_t<sizeof(physicslib::real) == 4, std::uint32_t, std::uint64_t>;
+
+	struct Result
+	{
+		std::string kernel;
+		std::size_t sample;
+		physicslib::real value;
+	};
+
+	class Recorder
+	{
+	public:
+		explicit Recorder(std::vector<Result>& results)
+			: m_results(results)
+		{
+		}
+
+		void add(const char* kernel, std::size_t sample, physicslib::real value)
+		{
+			m_results.push_back(Result { kernel, sample, value });
+		}
+
+		void add(const char* kernel, std::size_t sample, const physicslib::Vector3& vector)
+		{
+			add(kernel, sample, vector.getX());
+			add(kernel, sample, vector.getY());
+			add(kernel, sample, vector.getZ());
+		}
+
+		void add(const char* kernel, std::size_t sample, const physicslib::Quaternion& quaternion)
+		{
+			add(kernel, sample, quaternion.getR());
+			add(kernel, sample, quaternion.getI());
+			add(kernel, sample, quaternion.getJ());
+			add(kernel, sample, quaternion.getK());
+		}
+
+		template <std::size_t Rows, std::size_t Columns>
+		void add(const char* kernel, std::size_t sample, const physicslib::Matrix<Rows, Columns>& matrix)
+		{
+			for (std::size_t row = 0; row < Rows; ++row)
+			{
+				for (std::size_t column = 0; column < Columns; ++column)
+				{
+					add(kernel, sample, matrix(row, column));
+				}
+			}
+		}
+
+	private:
+		std::vector<Result>& m_results;
+	};
+
+	class Generator
+	{
+	public:
+		explicit Generator(unsigned int seed)
+			: m_generator(seed)
+		{
+		}
+
+		/**
+		 * Get a random real of [min, max[, drawn as a double so that both scalar types get the same sequence
+		 */
+		physicslib::real getReal(double min, double max)
+		{
+			return physicslib::real(min + (max - min) * std::generate_canonical<double, 53>(m_generator));
+		}
+
+		physicslib::Vector3 getVector3()
+		{
+			return physicslib::Vector3(getReal(-10, 10), getReal(-10, 10), getReal(-10, 10));
+		}
+
+		physicslib::Quaternion getQuaternion()
+		{
+			return physicslib::Quaternion(getReal(-1, 1), getReal(-1, 1), getReal(-1, 1), getReal(-1, 1));
+		}
+
+		template <std::size_t Rows, std::size_t Columns>
+		physicslib::Matrix<Rows, Columns> getMatrix()
+		{
+			physicslib::Matrix<Rows, Columns> matrix;
+			for (std::size_t row = 0; row < Rows; ++row)
+			{
+				for (std::size_t column = 0; column < Columns; ++column)
+				{
+					matrix(row, column) = getReal(-10, 10);
+				}
+			}
+
+			return matrix;
+		}
+
+	private:
+		std::mt19937 m_generator;
+	};
+
+	void runVector3Kernels(Generator& generator, std::size_t sample, Recorder& recorder)
+	{
+		const physicslib::Vector3 a = generator.getVector3();
+		const physicslib::Vector3 b = generator.getVector3();
+		const physicslib::real scalar = generator.getReal(0.5, 10);
+		const physicslib::Matrix3 matrix = generator.getMatrix<3, 3>();
+
+		recorder.add("vector3.negate", sample, -a);
+		recorder.add("vector3.add", sample, a + b);
+		recorder.add("vector3.subtract", sample, a - b);
+		recorder.add("vector3.dot", sample, a * b);
+		recorder.add("vector3.cross", sample, a ^ b);
+		recorder.add("vector3.multiply", sample, a * scalar);
+		recorder.add("vector3.divide", sample, a / scalar);
+		recorder.add("vector3.componentProduct", sample, a.ComponentProduct(b));
+		recorder.add("vector3.norm", sample, a.getNorm());
+		recorder.add("vector3.squaredNorm", sample, a.getSquaredNorm());
+		recorder.add("vector3.normalize", sample, a.getNormalizedVector());
+		recorder.add("vector3.localToWorld", sample, a.localToWorld(matrix));
+		recorder.add("vector3.worldToLocal", sample, a.worldToLocal(matrix));
+
+		physicslib::Vector3 accumulator = a;
+		accumulator += b;
+		accumulator -= a * scalar;
+		accumulator *= scalar;
+		accumulator /= scalar + 1;
+		recorder.add("vector3.compoundAssignments", sample, accumulator);
+	}
+
+	void runQuaternionKernels(Generator& generator, std::size_t sample, Recorder& recorder)
+	{
+		const physicslib::Quaternion a = generator.getQuaternion();
+		const physicslib::Quaternion b = generator.getQuaternion();
+		const physicslib::Vector3 vector = generator.getVector3();
+		const physicslib::real scalar = generator.getReal(0.5, 10);
+
+		recorder.add("quaternion.negate", sample, -a);
+		recorder.add("quaternion.multiply", sample, a * b);
+		recorder.add("quaternion.add", sample, a + b);
+		recorder.add("quaternion.scalarProduct", sample, a.ScalarProduct(b));
+		recorder.add("quaternion.norm", sample, a.getNorm());
+		recorder.add("quaternion.squaredNorm", sample, a.getSquaredNorm());
+		recorder.add("quaternion.normalize", sample, a.getNormalizedQuaternion());
+
+		physicslib::Quaternion scaled = a;
+		scaled *= scalar;
+		recorder.add("quaternion.scale", sample, scaled);
+
+		physicslib::Quaternion rotated = a;
+		rotated.rotate(vector);
+		recorder.add("quaternion.rotate", sample, rotated);
+
+		physicslib::Quaternion orientation = a.getNormalizedQuaternion();
+		orientation.updateOrientation(vector, physicslib::real(1) / 60);
+		recorder.add("quaternion.updateOrientation", sample, orientation);
+	}
+
+	void runMatrixKernels(Generator& generator, std::size_t sample, Recorder& recorder)
+	{
+		const physicslib::Matrix3 a3 = generator.getMatrix<3, 3>();
+		const physicslib::Matrix3 b3 = generator.getMatrix<3, 3>();
+		const physicslib::Matrix34 a34 = generator.getMatrix<3, 4>();
+		const physicslib::Matrix34 b34 = generator.getMatrix<3, 4>();
+		const physicslib::Vector3 vector = generator.getVector3();
+		const physicslib::Quaternion orientation = generator.getQuaternion().getNormalizedQuaternion();
+		const physicslib::real scalar = generator.getReal(0.5, 10);
+
+		recorder.add("matrix3.multiply", sample, a3 * b3);
+		recorder.add("matrix3.transform", sample, a3 * vector);
+		recorder.add("matrix3.add", sample, a3 + b3);
+		recorder.add("matrix3.subtract", sample, a3 - b3);
+		recorder.add("matrix3.negate", sample, -a3);
+		recorder.add("matrix3.determinant", sample, a3.getDeterminant());
+		recorder.add("matrix3.inverse", sample, a3.getReverseMatrix());
+		recorder.add("matrix3.transpose", sample, a3.getTransposedMatrix());
+		recorder.add("matrix3.fromQuaternion", sample, physicslib::Matrix3(orientation));
+
+		physicslib::Matrix3 scaled = a3;
+		scaled *= scalar;
+		scaled /= scalar + 1;
+		recorder.add("matrix3.scale", sample, scaled);
+
+		recorder.add("matrix34.multiply", sample, a34 * b34);
+		recorder.add("matrix34.transform", sample, a34 * vector);
+		recorder.add("matrix34.determinant", sample, a34.getDeterminant());
+		recorder.add("matrix34.inverse", sample, a34.getReverseMatrix());
+		recorder.add("matrix34.rotationInverse", sample, physicslib::Matrix34(physicslib::Matrix3(orientation), vector).getRotationInverse());
+	}
+
+	std::vector<Result> runKernels()
+	{
+		std::vector<Result> results;
+		Recorder recorder(results);
+		Generator generator(42);
+		for (std::size_t sample = 0; sample < SAMPLE_COUNT; ++sample)
+		{
+			runVector3Kernels(generator, sample, recorder);
+			runQuaternionKernels(generator, sample, recorder);
+			runMatrixKernels(generator, sample, recorder);
+		}
+
+		return results;
+	}
+
+	/**
+	 * Map the bits of `value` to an unsigned integer which grows with the value, so that the distance between
+	 * two mapped values is their distance in units in the last place
+	 */
+	Bits getOrderedBits(physicslib::real value)
+	{
+		const Bits signBit = Bits(1) << (sizeof(Bits) * 8 - 1);
+		Bits bits;
+		std::memcpy(&bits, &value, sizeof(bits));
+
+		return (bits & signBit) ? ~bits : bits | signBit;
+	}
+
+	std::uint64_t getUlpDistance(physicslib::real value, physicslib::real anotherValue)
+	{
+		if (std::isnan(value) || std::isnan(anotherValue))
+		{
+			return (std::isnan(value) && std::isnan(anotherValue)) ? 0 : UINT64_MAX;
+		}
+
+		const Bits bits = getOrderedBits(value);
+		const Bits otherBits = getOrderedBits(anotherValue);
+
+		return (bits > otherBits) ? bits - otherBits : otherBits - bits;
+	}
+
+	bool writeReference(const char* path, const std::vector<Result>& results)
+	{
+		std::FILE* file = std::fopen(path, "w");
+		if (file == nullptr)
+		{
+			std::fprintf(stderr, "Cannot write the reference file %s\n", path);
+			return false;
+		}
+
+		// Hexadecimal floating point keeps every bit of the values
+		for (const Result& result : results)
+		{
+			std::fprintf(file, "%s %zu %a\n", result.kernel.c_str(), result.sample, double(result.value));
+		}
+		std::fclose(file);
+
+		return true;
+	}
+
+	bool compareWithReference(const char* path, const std::vector<Result>& results)
+	{
+		std::FILE* file = std::fopen(path, "r");
+		if (file == nullptr)
+		{
+			std::fprintf(stderr, "Cannot read the reference file %s, run the scalar test first\n", path);
+			return false;
+		}
+
+		bool isValid = true;
+		std::uint64_t maxDistance = 0;
+		std::size_t failureCount = 0;
+		char kernel[64];
+		std::size_t sample;
+		double value;
+		std::size_t i = 0;
+		for (; i < results.size() && std::fscanf(file, "%63s %zu %la", kernel, &sample, &value) == 3; ++i)
+		{
+			const Result& result = results[i];
+			if (result.kernel != kernel || result.sample != sample)
+			{
+				std::fprintf(stderr, "The reference file does not match the kernels of the test at %s %zu\n", kernel, sample);
+				isValid = false;
+				break;
+			}
+
+			const std::uint64_t distance = getUlpDistance(result.value, physicslib::real(value));
+			maxDistance = (distance > maxDistance) ? distance : maxDistance;
+			if (distance > MAX_ULP)
+			{
+				if (failureCount < 20)
+				{
+					std::fprintf(stderr, "%s sample %zu: %.17g instead of %.17g (%" PRIu64 " ulp)\n",
+						kernel, sample, double(result.value), value, distance);
+				}
+				++failureCount;
+			}
+		}
+		std::fclose(file);
+
+		if (isValid && i != results.size())
+		{
+			std::fprintf(stderr, "The reference file has %zu values instead of %zu\n", i, results.size());
+			isValid = false;
+		}
+
+		std::printf("%zu values compared, max distance %" PRIu64 " ulp (tolerance %" PRIu64 " ulp), %zu failures\n",
+			i, maxDistance, MAX_ULP, failureCount);
+
+		return isValid && failureCount == 0;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	const bool isWriting = argc == 3 && std::strcmp(argv[1], "--write") == 0;
+	if (argc != 2 && !isWriting)
+	{
+		std::fprintf(stderr, "Usage: %s [--write] <referenceFile>\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	std::printf("real=%s simd=%s\n", physicslib::getRealName(), physicslib::simd::getBackendName());
+#if defined(PHYSICSLIB_SIMD_AVX2) && (defined(__GNUC__) || defined(__clang__))
+	if (!__builtin_cpu_supports("avx2"))
+	{
+		std::printf("The CPU does not support AVX2, skipped\n");
+		return SKIP_EXIT_CODE;
+	}
+#endif
+
+	const std::vector<Result> results = runKernels();
+	const bool isPassed = isWriting ? writeReference(argv[2], results) : compareWithReference(argv[1], results);
+
+	return isPassed ? EXIT_SUCCESS : EXIT_FAILURE;
+}